@@ -7,8 +7,16 @@
  * @date March, 2020
  */
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
 
 // Uses cxxopts from https://github.com/jarro2783/cxxopts under the MIT license
 #include "cxxopts/cxxopts.hxx"
@@ -16,6 +24,13 @@
 #include "grid.h"
 #include "world.h"
 #include "zoo.h"
+#include "checkpoint.h"
+#include "renderer.h"
+#include "shm_export.h"
+#include "snapshot.h"
+#include "job_server.h"
+#include "batch.h"
+#include "soup_search.h"
 
 int main(int argc, char *argv[]) {
 
@@ -29,6 +44,23 @@ int main(int argc, char *argv[]) {
             ("s,steps","The number of steps to simulate the world.", cxxopts::value<int>()->default_value("10"))
             ("e,every","Print world to the console every N steps. 0 disables printing.", cxxopts::value<int>()->default_value("0"))
             ("t,toroidal", "Simulate the Game of Life on a torus.", cxxopts::value<bool>()->default_value("false"))
+            ("a,ansi", "Redraw the world in place, only updating the rows that changed.", cxxopts::value<bool>()->default_value("false"))
+            ("v,viewport", "Only print the window x,y,width,height of the world.", cxxopts::value<std::string>())
+            ("c,checkpoint", "Periodically save the world to the provided path so the run can be resumed.", cxxopts::value<std::string>())
+            ("checkpoint-every", "Checkpoint every N steps. 0 disables.", cxxopts::value<int>()->default_value("1000"))
+            ("checkpoint-seconds", "Checkpoint every T seconds. 0 disables.", cxxopts::value<double>()->default_value("0"))
+            ("r,resume", "Resume from the checkpoint file if it exists.", cxxopts::value<bool>()->default_value("false"))
+            ("shm", "Export every generation to a shared memory ring with the provided name for shm_reader.", cxxopts::value<std::string>())
+            ("shm-takeover", "Take over the --shm name if it is already in use, such as after a crash.", cxxopts::value<bool>()->default_value("false"))
+            ("serve", "Run as a job server on the Unix domain socket at the provided path instead of simulating.", cxxopts::value<std::string>())
+            ("b,batch", "Simulate every file in a manifest, or matching a glob such as 'soups/*.gol', across all cores.", cxxopts::value<std::string>())
+            ("batch-output", "Save each final state of a batch to this directory.", cxxopts::value<std::string>())
+            ("batch-summary", "Write a csv of the populations and timings of a batch to the provided path.", cxxopts::value<std::string>())
+            ("batch-memory", "Roughly how many MiB of grids a batch may hold at once.", cxxopts::value<std::size_t>()->default_value("1024"))
+            ("soup", "Run N random soups to stabilisation on all cores and print a census of the objects they leave.", cxxopts::value<std::uint64_t>())
+            ("soup-size", "The width and height of each soup.", cxxopts::value<std::size_t>()->default_value("16"))
+            ("seed", "Picks the soups of a soup search.", cxxopts::value<std::uint64_t>()->default_value("1"))
+            ("q,quiet", "Only print populations, never the grids themselves.", cxxopts::value<bool>()->default_value("false"))
             ("h,help", "Print usage.");
 
     // Actually parse the command line arguments
@@ -40,16 +72,87 @@ int main(int argc, char *argv[]) {
         std::exit(0);
     }
 
+    // Serve simulation jobs to other processes until killed, see job_server.cpp for the protocol
+    if (result.count("serve")) {
+        try {
+            JobServer server(result["serve"].as<std::string>());
+            server.serve();
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
+    }
+
     // Parse the (potentially defaulted) parameters for this simulation
     const int  steps    = result["steps"].as<int>();
     const int  every    = result["every"].as<int>();
     const bool toroidal = result["toroidal"].as<bool>();
+    const bool resume   = result["resume"].as<bool>();
+    const bool ansi     = result["ansi"].as<bool>();
+    const bool quiet    = result["quiet"].as<bool>();
+    if (steps < 0) {
+        std::cerr << "--steps cannot be negative" << std::endl;
+        std::exit(-1);
+    }
+    if (result["checkpoint-every"].as<int>() < 0) {
+        std::cerr << "--checkpoint-every cannot be negative" << std::endl;
+        std::exit(-1);
+    }
+
+    // Take a census of the ash left by random soups, see soup_search.cpp for how objects are classified
+    if (result.count("soup")) {
+        SoupSearch search(result["seed"].as<std::uint64_t>(), result["soup-size"].as<std::size_t>());
+        SoupSearch::print(std::cout, search.run(result["soup"].as<std::uint64_t>()));
+        return 0;
+    }
+
+    // Simulate a whole batch of files instead of one, see batch.cpp for the manifest format
+    if (result.count("batch")) {
+        try {
+            BatchRunner runner(BatchRunner::parse(result["batch"].as<std::string>(), steps, toroidal),
+                               result.count("batch-output") ? result["batch-output"].as<std::string>() : "",
+                               result["batch-memory"].as<std::size_t>() << 20);
+            const auto results = runner.run(quiet ? nullptr : &std::cout);
+            if (result.count("batch-summary")) {
+                BatchRunner::write_summary(result["batch-summary"].as<std::string>(), results);
+            }
+            for (const auto& job : results) {
+                if (!job.error.empty()) {
+                    std::exit(-1);
+                }
+            }
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        return 0;
+    }
+
+    if (resume && !result.count("checkpoint")) {
+        std::cerr << "--resume needs a --checkpoint path to resume from" << std::endl;
+        std::exit(-1);
+    }
 
     // Start with an empty grid
     Grid grid;
+    std::uint64_t first_step = 0;
 
+    // Attempt to resume from the last checkpoint if asked to and one exists, otherwise fall back to the input file
+    if (resume && std::ifstream(result["checkpoint"].as<std::string>()).good()) {
+        try {
+            grid = Checkpointer::load(result["checkpoint"].as<std::string>(), first_step);
+            std::cout << "Resuming from step " << first_step << std::endl;
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+    }
     // Attempt to read in and parse the input file as an ascii .gol file if a path was given
-    if (result.count("file")) {
+    else if (result.count("file")) {
         try {
             grid = Zoo::load_ascii(result["file"].as<std::string>());
         }
@@ -62,26 +165,130 @@ int main(int argc, char *argv[]) {
     // Construct a world from the parsed grid
     World world(grid);
 
-    // Print the initial state of the grid
-    std::cout << "Initial state..." << std::endl
-              << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells()  << std::endl
-              << world.get_state() << std::endl;
+    // Snapshots are written on a background thread so stepping never waits on the disk
+    std::unique_ptr<Checkpointer> checkpointer;
+    if (result.count("checkpoint")) {
+        checkpointer.reset(new Checkpointer(result["checkpoint"].as<std::string>(),
+                                            static_cast<unsigned int>(result["checkpoint-every"].as<int>()),
+                                            result["checkpoint-seconds"].as<double>(), first_step));
+    }
+
+    // Generations are published to an exporter thread, which bit-packs every one of them into shared memory for
+    // other processes. Stepping waits only until the exporter has taken the previous generation, so the next step
+    // overlaps with writing it out and no generation is skipped
+    SnapshotPublisher publisher;
+    std::unique_ptr<ShmExporter> exporter;
+    std::thread export_thread;
+    std::mutex export_mutex;
+    std::condition_variable export_changed;
+    std::uint64_t exported = 0;
+    bool exporting = false;
+    if (result.count("shm")) {
+        try {
+            exporter.reset(new ShmExporter(result["shm"].as<std::string>(), world.get_width(), world.get_height(), 8,
+                                           true, result["shm-takeover"].as<bool>()));
+        }
+        catch (const std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            std::exit(-1);
+        }
+        world.set_snapshot_publisher(&publisher);
+        exporting = true;
+        export_thread = std::thread([&]() {
+            while (true) {
+                Snapshot snapshot;
+                {
+                    std::unique_lock<std::mutex> lock(export_mutex);
+                    export_changed.wait(lock, [&]() { return !exporting || world.get_generation() != exported; });
+                    if (world.get_generation() == exported) {
+                        return;
+                    }
+                    snapshot = publisher.acquire();
+                    exported = snapshot.get_generation();
+                }
+                export_changed.notify_all();
+                exporter->write(snapshot);
+            }
+        });
+    }
+
+    // Frames are formatted into a reused buffer and written in one go, optionally only a window of the world
+    Renderer renderer(ansi);
+    if (result.count("viewport")) {
+        std::size_t x = 0, y = 0, width = 0, height = 0;
+        char comma1 = 0, comma2 = 0, comma3 = 0;
+        std::istringstream viewport(result["viewport"].as<std::string>());
+        if (!(viewport >> x >> comma1 >> y >> comma2 >> width >> comma3 >> height) ||
+            comma1 != ',' || comma2 != ',' || comma3 != ',') {
+            std::cerr << "--viewport should be given as x,y,width,height" << std::endl;
+            std::exit(-1);
+        }
+        renderer.set_viewport(x, y, width, height);
+    }
+
+    // Plain frames are followed by a blank line as they always have been, ANSI frames are redrawn in place
+    auto render_frame = [&renderer, &world, ansi](const std::string& caption) {
+        renderer.render(std::cout, world.get_state(), caption);
+        if (!ansi) {
+            std::cout << std::endl;
+        }
+    };
+
+    // Print the initial state of the grid, or just its population when quiet
+    const std::string initial_title = "Initial state...\nAlive " + std::to_string(world.get_alive_cells()) +
+                                      " | Dead " + std::to_string(world.get_dead_cells());
+    if (quiet) {
+        std::cout << initial_title << std::endl;
+    } else {
+        render_frame(initial_title);
+    }
 
     // Perform the requested number of update steps
-    for (int step = 0; step < steps; step++) {
-        world.step(toroidal);
+    for (std::uint64_t step = first_step; step < static_cast<std::uint64_t>(steps); step++) {
+        if (export_thread.joinable()) {
+            // Hold the step back until the exporter has taken the last generation, then hand it this one
+            std::unique_lock<std::mutex> lock(export_mutex);
+            export_changed.wait(lock, [&]() { return world.get_generation() == exported; });
+            world.step(toroidal);
+            lock.unlock();
+            export_changed.notify_all();
+        } else {
+            world.step(toroidal);
+        }
+
+        if (checkpointer) {
+            checkpointer->update(world.get_state(), step + 1);
+        }
 
         // Print the state of the grid every N steps
-        if ((every > 0) && (step % every == 0)) {
-            std::cout << "Step " << (step + 1) << " of " << steps << std::endl
-                      << world.get_state() << std::endl;
+        if (!quiet && (every > 0) && (step % every == 0)) {
+            render_frame("Step " + std::to_string(step + 1) + " of " + std::to_string(steps));
         }
     }
 
-    // Print the final state of the grid
-    std::cout << "Final state..." << std::endl
-              << "Alive " << world.get_alive_cells() << " | Dead " << world.get_dead_cells()  << std::endl
-              << world.get_state() << std::endl;
+    // Let the exporter write out the final generation
+    if (export_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(export_mutex);
+            exporting = false;
+        }
+        export_changed.notify_all();
+        export_thread.join();
+    }
+
+    // Always leave a checkpoint of the final state behind
+    if (checkpointer) {
+        checkpointer->checkpoint(world.get_state(), std::max<std::uint64_t>(first_step, steps));
+    }
+
+    // Print the final state of the grid, or just its population when quiet
+    const std::string final_title = "Final state...\nAlive " + std::to_string(world.get_alive_cells()) +
+                                    " | Dead " + std::to_string(world.get_dead_cells());
+    if (quiet) {
+        std::cout << final_title << std::endl;
+    } else {
+        render_frame(final_title);
+    }
 
     // Attempt to save to the output directory if a path was given
     if (result.count("output")) {
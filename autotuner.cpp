@@ -0,0 +1,525 @@
+/**
+ * Implements an Autotuner that picks the fastest way of stepping a grid by timing the candidates on it, and a
+ * TunedWorld that steps with whatever the Autotuner picked.
+ *      - The candidates are a World in each StepMode over a few thread counts, a TileWorld over a few tile sizes
+ *        and an EventWorld. Which one wins depends on the machine, the size of the grid and how much of it is
+ *        alive and moving, so the only reliable way to choose is to time them on the grid itself.
+ *      - Each candidate is warmed up and then timed for a few steps from the same state.
+ *      - The winner is kept in a cache file, one line per CPU model and grid shape, so the next run can skip
+ *        the timing. A missing or unreadable cache is simply treated as empty.
+ *      - A TunedWorld keeps an eye on the density of alive cells, and times the candidates again when it has
+ *        moved a long way from where they were last timed.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "autotuner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    //Grids bigger than this are too slow to time the serial engine on
+    const std::size_t max_serial_cells = std::size_t(256) << 10;
+
+    //The tile sizes worth trying
+    const std::size_t tile_sizes[] = {16, 32, 64};
+
+    //A TileWorld needs a couple of cycles of the longest period it looks for before anything can freeze
+    const std::size_t tile_warmup = 34;
+
+    //How far the density of alive cells has to move, relative to where it was, before retuning
+    const double density_change = 0.5;
+
+    double density(const Grid& state) {
+        const std::size_t total = state.get_total_cells();
+        return (total == 0) ? 0.0 : static_cast<double>(state.get_alive_cells()) / static_cast<double>(total);
+    }
+}
+
+/**
+ * EngineConfig::to_string()
+ *
+ * @return
+ *      A short human readable description of the config, such as "bands, 8 threads" or "tiles, 32x32".
+ */
+std::string EngineConfig::to_string() const {
+    const std::string count = (threads == 0) ? "all" : std::to_string(threads);
+    switch (engine){
+        case Engine::Serial:
+            return "serial";
+        case Engine::Bands:
+            return "bands, " + count + " threads";
+        case Engine::Wavefront:
+            return "wavefront, " + count + " threads";
+        case Engine::Tiles:
+            return "tiles, " + std::to_string(tile_size) + "x" + std::to_string(tile_size);
+        case Engine::Events:
+            return "events";
+    }
+    return "unknown";
+}
+
+/**
+ * Autotuner::Autotuner(cache_path = ".gol_tune")
+ *
+ * Construct an autotuner, reading any results already in the cache file.
+ *
+ * @param cache_path
+ *      Optional parameter. The file results are kept in between runs, or an empty string to keep them in
+ *      memory only. Defaults to ".gol_tune" in the working directory.
+ */
+Autotuner::Autotuner(const std::string& cache_path) : cache_path(cache_path), cpu(cpu_model()) {
+    load_cache();
+}
+
+/**
+ * Autotuner::cpu_model()
+ *
+ * @return
+ *      The model name of the CPU from /proc/cpuinfo, or "unknown" where that is not available.
+ */
+std::string Autotuner::cpu_model() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)){
+        if (line.compare(0, 10, "model name") == 0){
+            const std::size_t colon = line.find(':');
+            if (colon != std::string::npos){
+                const std::size_t start = line.find_first_not_of(" \t", colon + 1);
+                return (start == std::string::npos) ? "unknown" : line.substr(start);
+            }
+        }
+    }
+    return "unknown";
+}
+
+/**
+ * Autotuner::load_cache()
+ *
+ * Private helper that reads the cache file. Each line holds the CPU model, width, height, whether the grid is
+ * toroidal, the engine, tile size, thread count and the time per step, separated by tabs. Lines that cannot be
+ * read are skipped.
+ */
+void Autotuner::load_cache() {
+    if (cache_path.empty()){
+        return;
+    }
+    std::ifstream file(cache_path);
+    std::string line;
+    while (std::getline(file, line)){
+        std::istringstream fields(line);
+        Entry entry;
+        std::string value;
+        unsigned int engine = 0;
+        if (!std::getline(fields, entry.cpu, '\t')){
+            continue;
+        }
+        std::vector<std::string> rest;
+        while (std::getline(fields, value, '\t')){
+            rest.push_back(value);
+        }
+        if (rest.size() != 7){
+            continue;
+        }
+        try {
+            entry.width = std::stoull(rest[0]);
+            entry.height = std::stoull(rest[1]);
+            entry.toroidal = rest[2] == "1";
+            engine = static_cast<unsigned int>(std::stoul(rest[3]));
+            entry.config.tile_size = std::stoull(rest[4]);
+            entry.config.threads = static_cast<unsigned int>(std::stoul(rest[5]));
+            entry.step_nanoseconds = std::stod(rest[6]);
+        } catch (const std::exception&){
+            continue;
+        }
+        if (engine > static_cast<unsigned int>(Engine::Events) ||
+            (static_cast<Engine>(engine) == Engine::Tiles && entry.config.tile_size == 0)){
+            continue;
+        }
+        entry.config.engine = static_cast<Engine>(engine);
+        entries.push_back(entry);
+    }
+}
+
+/**
+ * Autotuner::save_cache()
+ *
+ * Private helper that writes every result to the cache file, through a temporary file and a rename so other
+ * runs never see half a cache. Failing to save is reported but not an error, the results just are not kept.
+ */
+void Autotuner::save_cache() const {
+    if (cache_path.empty()){
+        return;
+    }
+    const std::string temporary = cache_path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        for (const Entry &entry : entries){
+            file << entry.cpu << '\t' << entry.width << '\t' << entry.height << '\t' << (entry.toroidal ? 1 : 0)
+                 << '\t' << static_cast<unsigned int>(entry.config.engine) << '\t' << entry.config.tile_size
+                 << '\t' << entry.config.threads << '\t' << entry.step_nanoseconds << '\n';
+        }
+        if (!file){
+            std::cerr << "Could not write the autotuner cache " << temporary << std::endl;
+            return;
+        }
+    }
+    if (std::rename(temporary.c_str(), cache_path.c_str()) != 0){
+        std::cerr << "Could not move the autotuner cache into place at " << cache_path << std::endl;
+    }
+}
+
+/**
+ * Autotuner::candidates(state)
+ *
+ * List the configs worth timing for a grid on this machine: a World in each step mode on one, half and all of
+ * the hardware threads, a TileWorld with each tile size and an EventWorld. The serial World is left out for
+ * grids so big that timing it would take longer than the rest put together.
+ *
+ * @param state
+ *      The grid the configs are for.
+ *
+ * @return
+ *      The configs to time.
+ */
+std::vector<EngineConfig> Autotuner::candidates(const Grid& state) {
+    const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned int> counts = {1, hardware / 2, hardware};
+    counts.erase(std::remove(counts.begin(), counts.end(), 0u), counts.end());
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+
+    std::vector<EngineConfig> configs;
+    if (state.get_total_cells() <= max_serial_cells){
+        configs.push_back({Engine::Serial, 0, 1});
+    }
+    for (const unsigned int threads : counts){
+        configs.push_back({Engine::Bands, 0, threads});
+    }
+    for (const unsigned int threads : counts){
+        if (threads > 1){
+            configs.push_back({Engine::Wavefront, 0, threads});
+        }
+    }
+    for (const std::size_t tile_size : tile_sizes){
+        configs.push_back({Engine::Tiles, tile_size, 0});
+    }
+    configs.push_back({Engine::Events, 0, 0});
+    return configs;
+}
+
+/**
+ * Autotuner::measure(config, state, toroidal, steps)
+ *
+ * Time a config on a copy of a state. The engine is built and warmed up by stepping it first, so one-off costs
+ * are not counted, then timed for the given number of steps. A TileWorld is warmed up for long enough that its
+ * oscillating tiles can freeze, since that is where its speed comes from. A wavefront only runs as many threads
+ * as steps it is given at once, so it is timed for at least as many steps as it has threads.
+ *
+ * The thread count is given to the engine itself, the count shared through GridMemory is left alone so worlds
+ * stepped elsewhere in the program are not affected.
+ *
+ * @param config
+ *      The config to time.
+ *
+ * @param state
+ *      The state to start from.
+ *
+ * @param toroidal
+ *      Whether to step the grid as a torus.
+ *
+ * @param steps
+ *      How many steps to time.
+ *
+ * @return
+ *      The average time a step took, in nanoseconds.
+ */
+double Autotuner::measure(const EngineConfig& config, const Grid& state, const bool toroidal, const std::size_t steps) {
+    using clock = std::chrono::steady_clock;
+
+    clock::duration taken{};
+    std::size_t timed = steps;
+    switch (config.engine){
+        case Engine::Serial:
+        case Engine::Bands:
+        case Engine::Wavefront: {
+            World world(state);
+            world.set_step_mode((config.engine == Engine::Serial) ? StepMode::Serial :
+                                (config.engine == Engine::Bands) ? StepMode::Bands : StepMode::Wavefront);
+            world.set_threads(config.threads);
+
+            //A wavefront only runs as many threads as there are steps in one advance
+            if (config.engine == Engine::Wavefront){
+                timed = std::max<std::size_t>(steps, world.get_threads());
+            }
+            world.advance(timed, toroidal);
+            const auto start = clock::now();
+            world.advance(timed, toroidal);
+            taken = clock::now() - start;
+            break;
+        }
+        case Engine::Tiles: {
+            TileWorld world(state, config.tile_size);
+            world.advance(std::max(steps, tile_warmup), toroidal);
+            const auto start = clock::now();
+            world.advance(steps, toroidal);
+            taken = clock::now() - start;
+            break;
+        }
+        case Engine::Events: {
+            EventWorld world(state, toroidal);
+            world.advance(steps, toroidal);
+            const auto start = clock::now();
+            world.advance(steps, toroidal);
+            taken = clock::now() - start;
+            break;
+        }
+    }
+
+    const double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(taken).count());
+    return nanoseconds / static_cast<double>(std::max<std::size_t>(timed, 1));
+}
+
+/**
+ * Autotuner::tune(state, toroidal, steps = 4)
+ *
+ * Time every candidate on the state and pick the fastest. The result replaces any earlier one in the cache for
+ * this machine and shape of grid, and the cache file is saved.
+ *
+ * @example
+ *
+ *      // Find out which engine suits a soup best on this machine
+ *      Autotuner tuner;
+ *      std::cout << tuner.tune(soup, true).to_string() << std::endl;
+ *
+ * @param state
+ *      The state to time the candidates on.
+ *
+ * @param toroidal
+ *      Whether the grid is stepped as a torus.
+ *
+ * @param steps
+ *      Optional parameter. How many steps to time each candidate for. Defaults to 4.
+ *
+ * @return
+ *      The fastest config.
+ */
+EngineConfig Autotuner::tune(const Grid& state, const bool toroidal, const std::size_t steps) {
+    EngineConfig best{Engine::Bands, 0, 0};
+    double best_time = -1.0;
+    for (const EngineConfig &config : candidates(state)){
+        const double time = measure(config, state, toroidal, steps);
+        if (best_time < 0.0 || time < best_time){
+            best = config;
+            best_time = time;
+        }
+    }
+
+    const Entry entry{cpu, state.get_width(), state.get_height(), toroidal, best, best_time};
+    auto existing = std::find_if(entries.begin(), entries.end(), [&](const Entry &other) {
+        return other.cpu == entry.cpu && other.width == entry.width && other.height == entry.height &&
+               other.toroidal == entry.toroidal;
+    });
+    if (existing != entries.end()){
+        *existing = entry;
+    } else {
+        entries.push_back(entry);
+    }
+    save_cache();
+    return best;
+}
+
+/**
+ * Autotuner::lookup(width, height, toroidal, config)
+ *
+ * Find the remembered config for a shape of grid on this machine.
+ *
+ * @param width
+ *      The width of the grid.
+ *
+ * @param height
+ *      The height of the grid.
+ *
+ * @param toroidal
+ *      Whether the grid is stepped as a torus.
+ *
+ * @param config
+ *      Set to the remembered config if there is one.
+ *
+ * @return
+ *      Whether a config was found.
+ */
+bool Autotuner::lookup(const std::size_t width, const std::size_t height, const bool toroidal,
+                       EngineConfig &config) const {
+    for (const Entry &entry : entries){
+        if (entry.cpu == cpu && entry.width == width && entry.height == height && entry.toroidal == toroidal){
+            config = entry.config;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * TunedWorld::TunedWorld(initial_state, toroidal = false, cache_path = ".gol_tune", recheck_steps = 1000)
+ *
+ * Construct a world that steps with the fastest engine for it. If the cache has a result for this machine and
+ * shape of grid it is used straight away, otherwise the candidates are timed on the initial state first.
+ *
+ * @example
+ *
+ *      // Run a big soup for a long time with whatever suits it best as it settles
+ *      TunedWorld world(soup, true);
+ *      world.advance(100000);
+ *      std::cout << "Finished on " << world.get_config().to_string() << std::endl;
+ *
+ * @param initial_state
+ *      The state of the world to start from.
+ *
+ * @param toroidal
+ *      Optional parameter. Whether the world is stepped as a torus. Defaults to false.
+ *
+ * @param cache_path
+ *      Optional parameter. The autotuner cache file, or an empty string for none. Defaults to ".gol_tune".
+ *
+ * @param recheck_steps
+ *      Optional parameter. How often to check whether the density has changed enough to retune, or 0 to never
+ *      retune. Defaults to 1000.
+ */
+TunedWorld::TunedWorld(const Grid& initial_state, const bool toroidal, const std::string& cache_path,
+                       const std::size_t recheck_steps) :
+        tuner(cache_path),
+        config{Engine::Bands, 0, 0},
+        toroidal(toroidal),
+        world(initial_state),
+        recheck_steps(recheck_steps),
+        since_check(0),
+        tuned_density(density(initial_state)) {
+    EngineConfig chosen{Engine::Bands, 0, 0};
+    if (!tuner.lookup(initial_state.get_width(), initial_state.get_height(), toroidal, chosen)){
+        chosen = tuner.tune(initial_state, toroidal);
+    }
+    apply(chosen);
+}
+
+/**
+ * TunedWorld::apply(config)
+ *
+ * Private helper that moves the current state into a new engine.
+ */
+void TunedWorld::apply(const EngineConfig& config) {
+    const Grid state = get_state();
+    world = World();
+    tiles.reset();
+    events.reset();
+
+    switch (config.engine){
+        case Engine::Serial:
+        case Engine::Bands:
+        case Engine::Wavefront:
+            world = World(state);
+            world.set_step_mode((config.engine == Engine::Serial) ? StepMode::Serial :
+                                (config.engine == Engine::Bands) ? StepMode::Bands : StepMode::Wavefront);
+            world.set_threads(config.threads);
+            break;
+        case Engine::Tiles:
+            tiles.reset(new TileWorld(state, config.tile_size));
+            break;
+        case Engine::Events:
+            events.reset(new EventWorld(state, toroidal));
+            break;
+    }
+    this->config = config;
+}
+
+/**
+ * TunedWorld::retune()
+ *
+ * Private helper that times the candidates again on the current state, switching engine if another has
+ * become faster.
+ */
+void TunedWorld::retune() {
+    const EngineConfig chosen = tuner.tune(get_state(), toroidal);
+    tuned_density = density(get_state());
+    if (chosen.engine != config.engine || chosen.tile_size != config.tile_size || chosen.threads != config.threads){
+        apply(chosen);
+    }
+}
+
+/**
+ * TunedWorld::advance_engine(steps)
+ *
+ * Private helper that steps whichever engine is in use.
+ */
+void TunedWorld::advance_engine(const std::size_t steps) {
+    if (tiles){
+        tiles->advance(steps, toroidal);
+    } else if (events){
+        events->advance(steps, toroidal);
+    } else {
+        world.advance(steps, toroidal);
+    }
+}
+
+/**
+ * TunedWorld::get_state()
+ *
+ * @return
+ *      A read-only reference to the current state, held by whichever engine is in use.
+ */
+const Grid& TunedWorld::get_state() const {
+    if (tiles){
+        return tiles->get_state();
+    }
+    if (events){
+        return events->get_state();
+    }
+    return world.get_state();
+}
+
+/**
+ * TunedWorld::get_config()
+ *
+ * @return
+ *      The config currently being used to step the world.
+ */
+const EngineConfig& TunedWorld::get_config() const {
+    return config;
+}
+
+/**
+ * TunedWorld::advance(steps)
+ *
+ * Advance multiple steps in the Game of Life. Every recheck_steps generations the density of alive cells is
+ * compared with the density the engine was chosen for, and if it has changed by more than half the candidates
+ * are timed again from the current state.
+ *
+ * @param steps
+ *      The number of steps to advance the world forward.
+ */
+void TunedWorld::advance(std::size_t steps) {
+    while (steps > 0){
+        const std::size_t chunk = (recheck_steps == 0) ? steps : std::min(steps, recheck_steps - since_check);
+        advance_engine(chunk);
+        steps -= chunk;
+        if (recheck_steps == 0){
+            continue;
+        }
+
+        since_check += chunk;
+        if (since_check == recheck_steps){
+            since_check = 0;
+            const double now = density(get_state());
+            if (std::abs(now - tuned_density) > density_change * std::max(tuned_density, 0.01)){
+                retune();
+            }
+        }
+    }
+}
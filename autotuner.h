@@ -0,0 +1,124 @@
+/**
+ * Declares an Autotuner that picks the fastest way of stepping a grid by timing the candidates on it, and a
+ * TunedWorld that steps with whatever the Autotuner picked.
+ * Rich documentation for the api and behaviour of the Autotuner and TunedWorld classes can be found in
+ * autotuner.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "event_world.h"
+#include "tile_world.h"
+#include "world.h"
+
+/**
+ * The engines a grid can be stepped with.
+ *      - Serial, Bands, Wavefront: a World in that StepMode.
+ *      - Tiles: a TileWorld, which freezes still and oscillating tiles.
+ *      - Events: an EventWorld, which only updates around changed cells.
+ */
+enum class Engine : unsigned char {
+    Serial,
+    Bands,
+    Wavefront,
+    Tiles,
+    Events
+};
+
+/**
+ * A way of stepping a grid: the engine, the tile size if it is Tiles, and how many threads to use if it is
+ * Bands or Wavefront, 0 meaning one per hardware thread.
+ */
+struct EngineConfig {
+    Engine engine;
+    std::size_t tile_size;
+    unsigned int threads;
+
+    std::string to_string() const;
+};
+
+/**
+ * Declare the structure of the Autotuner class, which times candidate engines on a grid and remembers the winner.
+ *
+ * Results are kept in a cache file keyed by the CPU model and the shape of the grid, so a later run on the same
+ * machine with the same shape of grid can start with the right engine without timing anything.
+ */
+class Autotuner {
+private:
+    struct Entry {
+        std::string cpu;
+        std::size_t width;
+        std::size_t height;
+        bool toroidal;
+        EngineConfig config;
+        double step_nanoseconds;
+    };
+
+    std::string cache_path;
+    std::string cpu;
+    std::vector<Entry> entries;
+
+    void load_cache();
+    void save_cache() const;
+
+public:
+    //An empty cache path keeps the results in memory only
+    explicit Autotuner(const std::string& cache_path = ".gol_tune");
+
+    //The candidates worth timing for a grid on this machine
+    static std::vector<EngineConfig> candidates(const Grid& state);
+
+    //Times one candidate for a few steps from the given state, returning nanoseconds per step
+    static double measure(const EngineConfig& config, const Grid& state, bool toroidal, std::size_t steps);
+
+    //Times every candidate from the given state, remembers the fastest in the cache and returns it
+    EngineConfig tune(const Grid& state, bool toroidal, std::size_t steps = 4);
+
+    //Looks up the remembered config for a shape of grid on this machine, returning whether there was one
+    bool lookup(std::size_t width, std::size_t height, bool toroidal, EngineConfig &config) const;
+
+    //The model name of this machine's CPU, as used in the cache
+    static std::string cpu_model();
+};
+
+/**
+ * Declare the structure of the TunedWorld class, a world that steps with the engine chosen by an Autotuner.
+ *
+ * Every recheck_steps generations the density of alive cells is compared with the density when the engine was
+ * chosen. If it has moved a long way, for example from a dense soup to sparse ash, the engines are timed again.
+ */
+class TunedWorld {
+private:
+    Autotuner tuner;
+    EngineConfig config;
+    bool toroidal;
+
+    //Only the engine in use holds the state, the others are empty
+    World world;
+    std::unique_ptr<TileWorld> tiles;
+    std::unique_ptr<EventWorld> events;
+
+    std::size_t recheck_steps;
+    std::size_t since_check;
+    double tuned_density;
+
+    //Moves the current state into the engine described by config
+    void apply(const EngineConfig& config);
+    void retune();
+    void advance_engine(std::size_t steps);
+
+public:
+    TunedWorld(const Grid& initial_state, bool toroidal = false, const std::string& cache_path = ".gol_tune",
+               std::size_t recheck_steps = 1000);
+
+    const Grid& get_state() const;
+    const EngineConfig& get_config() const;
+
+    //Steps the world with the chosen engine, retuning if the density has changed enough
+    void advance(std::size_t steps);
+};
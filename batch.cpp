@@ -0,0 +1,350 @@
+/**
+ * Implements a runner that simulates many pattern files at once, for the --batch mode of Game_of_Life.
+ *      - Files are loaded one at a time on the calling thread and handed to a ThreadPool to be stepped, so
+ *        reading and parsing the next file overlaps with stepping the ones before it.
+ *      - Before loading a file the runner reads just its header to estimate how much memory the job will hold,
+ *        and waits for running jobs to finish while loading it would go over the memory budget. A job bigger
+ *        than the whole budget still runs, on its own.
+ *      - Results are saved as each job finishes, and collected in the order of the jobs for the summary.
+ *
+ *        A manifest has one job per line: the path of a .gol or .bgol file, optionally followed by steps=N
+ *        and toroidal=0|1 to override the defaults for that file. Relative paths are relative to the manifest.
+ *        Blank lines and lines starting with # are ignored.
+ *
+ *          # A manifest
+ *          gliders/small.gol
+ *          soups/big.bgol steps=5000 toroidal=1
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "batch.h"
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <glob.h>
+#include <sys/stat.h>
+#include "grid.h"
+#include "thread_pool.h"
+#include "world.h"
+#include "zoo.h"
+
+namespace {
+    bool is_binary(const std::string& path) {
+        return path.size() >= 5 && path.compare(path.size() - 5, 5, ".bgol") == 0;
+    }
+
+    std::string base_name(const std::string& path) {
+        const std::size_t slash = path.find_last_of('/');
+        return (slash == std::string::npos) ? path : path.substr(slash + 1);
+    }
+
+    double milliseconds_since(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    //Quotes a field for the summary if it would otherwise break the csv
+    std::string csv_field(const std::string& text) {
+        if (text.find_first_of(",\"\n") == std::string::npos) {
+            return text;
+        }
+        std::string quoted = "\"";
+        for (const char c : text) {
+            quoted += (c == '"') ? "\"\"" : std::string(1, c);
+        }
+        return quoted + "\"";
+    }
+}
+
+/**
+ * BatchRunner::BatchRunner(jobs, output_dir = "", memory_budget = 1 GiB, threads = 0)
+ *
+ * Construct a runner for a list of jobs.
+ *
+ * @example
+ *
+ *      // Run every soup for 1000 generations, saving the results and a summary
+ *      BatchRunner runner(BatchRunner::parse("soups/soup_*.gol", 1000, false), "out");
+ *      BatchRunner::write_summary("out/summary.csv", runner.run(&std::cout));
+ *
+ * @param jobs
+ *      The files to simulate.
+ *
+ * @param output_dir
+ *      Optional parameter. The directory each final state is saved to under the name of its input file, created
+ *      if it does not exist. Empty to not save anything. Defaults to empty.
+ *
+ * @param memory_budget
+ *      Optional parameter. Roughly how many bytes of grids may be held by jobs in flight. Defaults to 1 GiB.
+ *
+ * @param threads
+ *      Optional parameter. The number of threads stepping, 0 for one per hardware thread. Defaults to 0.
+ */
+BatchRunner::BatchRunner(std::vector<Job> jobs, const std::string& output_dir, const std::size_t memory_budget,
+                         const unsigned int threads)
+    : jobs(std::move(jobs)), output_dir(output_dir), memory_budget(memory_budget), threads(threads) {
+}
+
+/**
+ * BatchRunner::parse(manifest_or_glob, steps, toroidal)
+ *
+ * Build the list of jobs from a manifest file or a glob pattern. See the top of this file for the manifest format.
+ *
+ * @param manifest_or_glob
+ *      The path of a manifest, or a pattern such as soups/soup_*.gol if it contains *, ? or [.
+ *
+ * @param steps
+ *      The number of steps for any job that does not say otherwise.
+ *
+ * @param toroidal
+ *      Whether jobs that do not say otherwise are simulated on a torus.
+ *
+ * @return
+ *      The jobs, in manifest order or sorted by path for a glob.
+ *
+ * @throws
+ *      std::runtime_error if the manifest cannot be read or has an invalid line, or the glob matches nothing.
+ */
+std::vector<BatchRunner::Job> BatchRunner::parse(const std::string& manifest_or_glob, const std::size_t steps,
+                                                 const bool toroidal) {
+    std::vector<Job> jobs;
+
+    if (manifest_or_glob.find_first_of("*?[") != std::string::npos) {
+        glob_t matches{};
+        const int status = ::glob(manifest_or_glob.c_str(), 0, nullptr, &matches);
+        if (status == 0) {
+            for (std::size_t i = 0; i < matches.gl_pathc; i++) {
+                jobs.push_back(Job{matches.gl_pathv[i], steps, toroidal});
+            }
+        }
+        ::globfree(&matches);
+        if (jobs.empty()) {
+            throw std::runtime_error("No files match " + manifest_or_glob);
+        }
+        return jobs;
+    }
+
+    std::ifstream manifest(manifest_or_glob);
+    if (!manifest.is_open()) {
+        throw std::runtime_error("Cannot open manifest " + manifest_or_glob);
+    }
+    const std::size_t slash = manifest_or_glob.find_last_of('/');
+    const std::string directory = (slash == std::string::npos) ? "" : manifest_or_glob.substr(0, slash + 1);
+
+    std::string line;
+    std::size_t line_number = 0;
+    while (std::getline(manifest, line)) {
+        line_number++;
+        std::istringstream tokens(line);
+        std::string path;
+        if (!(tokens >> path) || path[0] == '#') {
+            continue;
+        }
+
+        Job job{(path[0] == '/') ? path : directory + path, steps, toroidal};
+        std::string option;
+        while (tokens >> option) {
+            if (option.compare(0, 6, "steps=") == 0 && option.size() > 6 &&
+                option.find_first_not_of("0123456789", 6) == std::string::npos) {
+                job.steps = std::stoull(option.substr(6));
+            } else if (option == "toroidal=1" || option == "toroidal=true") {
+                job.toroidal = true;
+            } else if (option == "toroidal=0" || option == "toroidal=false") {
+                job.toroidal = false;
+            } else {
+                throw std::runtime_error("Invalid option " + option + " on line " + std::to_string(line_number) +
+                                         " of " + manifest_or_glob);
+            }
+        }
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+/**
+ * BatchRunner::estimate_bytes(input)
+ *
+ * Estimate the memory a job holds at its peak, the loaded grid plus the two grids of the world stepping it,
+ * from the dimensions in the file's header.
+ *
+ * @param input
+ *      The path of a .gol or .bgol file.
+ *
+ * @return
+ *      The estimate in bytes, 0 if the header cannot be read. Loading the file will report the problem.
+ */
+std::size_t BatchRunner::estimate_bytes(const std::string& input) {
+    std::size_t width = 0, height = 0;
+    if (is_binary(input)) {
+        std::ifstream file(input, std::ios::in | std::ios::binary);
+        std::uint32_t dimensions[2] = {0, 0};
+        if (file.read(reinterpret_cast<char *>(dimensions), sizeof(dimensions))) {
+            width = dimensions[0];
+            height = dimensions[1];
+        }
+    } else {
+        std::ifstream file(input);
+        if (!(file >> width >> height)) {
+            return 0;
+        }
+    }
+    return 3 * width * height * sizeof(Cell);
+}
+
+/**
+ * BatchRunner::run(progress = nullptr)
+ *
+ * Run every job, loading on the calling thread while the pool steps and saves.
+ *
+ * @param progress
+ *      Optional parameter. A stream to print a line to as each job finishes, nullptr to stay quiet. Defaults
+ *      to nullptr.
+ *
+ * @return
+ *      A result for every job, in the order of the jobs. Jobs that fail are reported in their result rather
+ *      than stopping the batch.
+ *
+ * @throws
+ *      std::runtime_error if the output directory cannot be created, or two jobs have inputs with the same file
+ *      name and so would be saved to the same output.
+ */
+std::vector<BatchRunner::Result> BatchRunner::run(std::ostream *progress) {
+    std::vector<Result> results(jobs.size());
+    if (!output_dir.empty()) {
+        //Outputs are named after their input file, so two inputs with the same name would overwrite each other
+        std::map<std::string, std::string> outputs;
+        for (const Job& job : jobs) {
+            const auto output = outputs.emplace(base_name(job.input), job.input);
+            if (!output.second) {
+                throw std::runtime_error("Both " + output.first->second + " and " + job.input + " would be saved as " +
+                                         output_dir + "/" + output.first->first);
+            }
+        }
+        if (::mkdir(output_dir.c_str(), 0777) != 0 && errno != EEXIST) {
+            throw std::runtime_error("Cannot create output directory " + output_dir);
+        }
+    }
+
+    //Bytes held by jobs that have been loaded but not finished, and a lock for the progress stream
+    std::mutex mutex;
+    std::condition_variable released;
+    std::size_t in_flight = 0;
+
+    auto finish = [&](Result &result, const std::size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        in_flight -= bytes;
+        released.notify_all();
+        if (progress) {
+            if (result.error.empty()) {
+                *progress << result.input << ": Alive " << result.final_alive << " | Dead "
+                          << (result.width * result.height - result.final_alive) << " after " << result.steps
+                          << " steps in " << result.step_ms << " ms" << std::endl;
+            } else {
+                *progress << result.input << ": " << result.error << std::endl;
+            }
+        }
+    };
+
+    //Declared after everything its tasks use, so it finishes them before they are destroyed
+    ThreadPool pool(threads);
+
+    for (std::size_t i = 0; i < jobs.size(); i++) {
+        const Job &job = jobs[i];
+        Result &result = results[i];
+        result = Result{job.input, "", 0, 0, job.steps, job.toroidal, 0, 0, 0.0, 0.0, 0.0, ""};
+
+        //Wait for room in the budget, a job that does not fit even in an empty budget runs alone
+        const std::size_t bytes = estimate_bytes(job.input);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            released.wait(lock, [&] { return in_flight == 0 || in_flight + bytes <= memory_budget; });
+            in_flight += bytes;
+        }
+
+        std::shared_ptr<Grid> initial;
+        try {
+            const auto start = std::chrono::steady_clock::now();
+            initial = std::make_shared<Grid>(is_binary(job.input) ? Zoo::load_binary(job.input)
+                                                                  : Zoo::load_ascii(job.input));
+            result.load_ms = milliseconds_since(start);
+        } catch (const std::exception &ex) {
+            result.error = ex.what();
+            finish(result, bytes);
+            continue;
+        }
+
+        pool.submit([this, &job, &result, &finish, initial, bytes]() mutable {
+            try {
+                result.width = initial->get_width();
+                result.height = initial->get_height();
+                result.initial_alive = initial->get_alive_cells();
+
+                //The world keeps its own copy, so the loaded grid can go before stepping starts
+                World world(*initial);
+                initial.reset();
+
+                auto start = std::chrono::steady_clock::now();
+                world.advance(job.steps, job.toroidal);
+                result.step_ms = milliseconds_since(start);
+                result.final_alive = world.get_alive_cells();
+
+                if (!output_dir.empty()) {
+                    start = std::chrono::steady_clock::now();
+                    result.output = output_dir + "/" + base_name(job.input);
+                    if (is_binary(job.input)) {
+                        Zoo::save_binary(result.output, world.get_state());
+                    } else {
+                        Zoo::save_ascii(result.output, world.get_state());
+                    }
+                    result.save_ms = milliseconds_since(start);
+                }
+            } catch (const std::exception &ex) {
+                result.error = ex.what();
+            }
+            initial.reset();
+            finish(result, bytes);
+        });
+    }
+
+    pool.wait_idle();
+    return results;
+}
+
+/**
+ * BatchRunner::write_summary(path, results)
+ *
+ * Write the results of a batch as a csv file with a header row.
+ *
+ * @param path
+ *      The path of the csv file.
+ *
+ * @param results
+ *      The results returned by run.
+ *
+ * @throws
+ *      std::runtime_error if the file cannot be written.
+ */
+void BatchRunner::write_summary(const std::string& path, const std::vector<Result> &results) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        throw std::runtime_error("Cannot write summary " + path);
+    }
+    out << "input,output,width,height,steps,toroidal,initial_alive,final_alive,load_ms,step_ms,save_ms,error\n";
+    for (const Result& result : results) {
+        out << csv_field(result.input) << ',' << csv_field(result.output) << ','
+            << result.width << ',' << result.height << ',' << result.steps << ',' << (result.toroidal ? 1 : 0) << ','
+            << result.initial_alive << ',' << result.final_alive << ','
+            << result.load_ms << ',' << result.step_ms << ',' << result.save_ms << ','
+            << csv_field(result.error) << '\n';
+    }
+    if (!out) {
+        throw std::runtime_error("Cannot write summary " + path);
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * Declares a runner that simulates many pattern files at once, for the --batch mode of Game_of_Life.
+ * Rich documentation for the api, behaviour and manifest format of the BatchRunner class can be found in batch.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Declare the structure of the BatchRunner class, which loads files on the calling thread while a ThreadPool
+ * steps the files already loaded, never holding more grids in memory than its budget allows.
+ */
+class BatchRunner {
+public:
+    //One file to simulate
+    struct Job {
+        std::string input;
+        std::size_t steps;
+        bool toroidal;
+    };
+
+    //What happened to a job, error is empty if it succeeded
+    struct Result {
+        std::string input;
+        std::string output;
+        std::size_t width;
+        std::size_t height;
+        std::size_t steps;
+        bool toroidal;
+        std::size_t initial_alive;
+        std::size_t final_alive;
+        double load_ms;
+        double step_ms;
+        double save_ms;
+        std::string error;
+    };
+
+private:
+    std::vector<Job> jobs;
+    std::string output_dir;
+    std::size_t memory_budget;
+    unsigned int threads;
+
+public:
+    //An empty output_dir means results are not saved, 0 threads means one per hardware thread
+    explicit BatchRunner(std::vector<Job> jobs, const std::string& output_dir = "",
+                         std::size_t memory_budget = std::size_t(1) << 30, unsigned int threads = 0);
+
+    //Reads a manifest file, or expands a glob if the argument contains *, ? or [
+    static std::vector<Job> parse(const std::string& manifest_or_glob, std::size_t steps, bool toroidal);
+
+    //How many bytes a job is expected to hold while it is in flight, read from the file's header
+    static std::size_t estimate_bytes(const std::string& input);
+
+    //Runs every job and returns the results in the order of the jobs, printing a line per job to progress if given
+    std::vector<Result> run(std::ostream *progress = nullptr);
+
+    static void write_summary(const std::string& path, const std::vector<Result> &results);
+};
@@ -0,0 +1,350 @@
+/**
+ * Implements a class for periodically saving the state of a long running simulation so it can be resumed.
+ *      - A checkpoint is taken every N generations, every T seconds, or whichever comes first if both are set.
+ *      - Taking a checkpoint only copies the current grid into a pending buffer, the file itself is written
+ *        by a background thread so stepping carries on while the disk catches up.
+ *      - If the writer falls behind, the pending snapshot is replaced by the newer one rather than queueing.
+ *
+ *      - Checkpoints are written to path + ".tmp", synced to disk and then renamed over path, and the rename
+ *        itself is synced by syncing the directory. So the file at path is always a complete checkpoint, even
+ *        if the process dies or the power goes part way through writing.
+ *
+ *      - Checkpoint files are composed of:
+ *          - a 4 byte magic number "GOLC"
+ *          - an 8 byte unsigned int holding the generation number
+ *          - an 8 byte unsigned int representing the grid width
+ *          - an 8 byte unsigned int representing the grid height
+ *          - followed by (width * height) bits packed exactly as in the .bgol binary format.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "checkpoint.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    const char magic[4] = {'G', 'O', 'L', 'C'};
+
+    //Flushes a file or directory all the way to the disk, returning false if it could not be
+    bool sync_to_disk(const std::string& path, const bool directory) {
+        const int descriptor = ::open(path.c_str(), directory ? (O_RDONLY | O_DIRECTORY) : O_WRONLY);
+        if (descriptor < 0){
+            return false;
+        }
+        const bool synced = ::fsync(descriptor) == 0;
+        ::close(descriptor);
+        return synced;
+    }
+}
+
+/**
+ * Checkpointer::Checkpointer(path, every_steps, every_seconds = 0, first_generation = 0)
+ *
+ * Construct a checkpointer and start its background writer thread.
+ *
+ * @example
+ *
+ *      // Checkpoint every 1000 generations or every 30 seconds, whichever comes first
+ *      Checkpointer checkpointer("run.ckpt", 1000, 30);
+ *
+ *      for (std::uint64_t generation = 1; generation <= steps; generation++) {
+ *          world.step();
+ *          checkpointer.update(world.get_state(), generation);
+ *      }
+ *
+ * @param path
+ *      The std::string path to write checkpoints to.
+ *
+ * @param every_steps
+ *      Take a checkpoint every this many generations, 0 disables this trigger.
+ *
+ * @param every_seconds
+ *      Optional parameter. Take a checkpoint once this many seconds have passed since the last one,
+ *      0 disables this trigger. Defaults to 0.
+ *
+ * @param first_generation
+ *      Optional parameter. The generation the run starts from, such as the one a resumed checkpoint was taken
+ *      at, so the first checkpoint is due every_steps generations after it. Defaults to 0.
+ */
+Checkpointer::Checkpointer(const std::string& path, const unsigned int every_steps, const double every_seconds,
+                           const std::uint64_t first_generation) :
+        path(path),
+        every_steps(every_steps),
+        every_duration(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(every_seconds))),
+        last_time(std::chrono::steady_clock::now()),
+        last_generation(first_generation),
+        pending_generation(0),
+        has_pending(false),
+        writing(false),
+        stopping(false),
+        worker(&Checkpointer::run, this){}
+
+/**
+ * Checkpointer::~Checkpointer()
+ *
+ * Write out any pending snapshot and stop the background writer thread.
+ */
+Checkpointer::~Checkpointer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+/**
+ * Checkpointer::run()
+ *
+ * Private body of the background writer thread. Waits for a snapshot, takes ownership of it by swapping
+ * it with its own buffer and writes it out without holding the lock.
+ */
+void Checkpointer::run() {
+    Grid snapshot;
+    std::uint64_t generation = 0;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return has_pending || stopping; });
+        if (!has_pending){
+            //Only reachable when stopping with nothing left to write
+            break;
+        }
+
+        //Swap buffers so the stepper can fill the pending one again while this one is written
+        std::swap(snapshot, pending);
+        generation = pending_generation;
+        has_pending = false;
+        writing = true;
+
+        lock.unlock();
+        try {
+            save(path, snapshot, generation);
+        } catch (const std::exception& ex) {
+            //There is nobody to throw to on this thread, so report it and keep the previous checkpoint
+            std::cerr << "Could not write checkpoint: " << ex.what() << std::endl;
+        }
+        lock.lock();
+
+        writing = false;
+        written.notify_all();
+    }
+}
+
+/**
+ * Checkpointer::update(state, generation)
+ *
+ * Take a snapshot if enough generations or time have passed since the last one.
+ * Should be called after every step, the time check is cheap.
+ *
+ * @param state
+ *      The current state of the world.
+ *
+ * @param generation
+ *      The generation number of that state.
+ *
+ * @return
+ *      True if a snapshot was taken.
+ */
+bool Checkpointer::update(const Grid& state, const std::uint64_t generation) {
+    bool due_steps = (every_steps != 0) && (generation - last_generation >= every_steps);
+    bool due_time = (every_duration.count() != 0) &&
+                    (std::chrono::steady_clock::now() - last_time >= every_duration);
+
+    if (!due_steps && !due_time){
+        return false;
+    }
+
+    {
+        //Copying into the pending buffer reuses its storage, the disk is never touched here
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = state;
+        pending_generation = generation;
+        has_pending = true;
+    }
+    wake.notify_one();
+
+    last_generation = generation;
+    last_time = std::chrono::steady_clock::now();
+    return true;
+}
+
+/**
+ * Checkpointer::checkpoint(state, generation)
+ *
+ * Take a snapshot regardless of when the last one was, and wait until it has been written.
+ * Useful at the end of a run.
+ *
+ * @param state
+ *      The current state of the world.
+ *
+ * @param generation
+ *      The generation number of that state.
+ */
+void Checkpointer::checkpoint(const Grid& state, const std::uint64_t generation) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = state;
+        pending_generation = generation;
+        has_pending = true;
+    }
+    wake.notify_one();
+
+    last_generation = generation;
+    last_time = std::chrono::steady_clock::now();
+    flush();
+}
+
+/**
+ * Checkpointer::flush()
+ *
+ * Block until every snapshot taken so far has been written to disk.
+ */
+void Checkpointer::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    written.wait(lock, [this] { return !has_pending && !writing; });
+}
+
+/**
+ * Checkpointer::save(path, state, generation)
+ *
+ * Synchronously write a checkpoint file, going through a temporary file and a rename so that the
+ * file at path is never left half written. The temporary file is synced before the rename and the directory
+ * after it, so a crash or power loss leaves either the old checkpoint or the new one, never an empty file.
+ *
+ * @example
+ *
+ *      // Save the current state of a world at generation 500
+ *      Checkpointer::save("run.ckpt", world.get_state(), 500);
+ *
+ * @param path
+ *      The std::string path to write the checkpoint to.
+ *
+ * @param state
+ *      The grid to write out.
+ *
+ * @param generation
+ *      The generation number to store alongside the grid.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be written or renamed.
+ */
+void Checkpointer::save(const std::string& path, const Grid& state, const std::uint64_t generation) {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream outFile(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!outFile.is_open()){
+            throw std::runtime_error("File with that name could not be opened");
+        }
+
+        std::uint64_t width = state.get_width();
+        std::uint64_t height = state.get_height();
+        outFile.write(magic, sizeof(magic));
+        outFile.write(reinterpret_cast<const char *>(&generation), sizeof(generation));
+        outFile.write(reinterpret_cast<const char *>(&width), sizeof(width));
+        outFile.write(reinterpret_cast<const char *>(&height), sizeof(height));
+
+        //Pack the cells into bytes a bit at a time, lowest bit first, then write them all at once
+        std::vector<unsigned char> bits((width * height + 7) / 8, 0);
+        std::size_t bit = 0;
+        for (std::size_t i = 0; i < height; i++){
+            const Cell *cells = state.row(i);
+            for (std::size_t j = 0; j < width; j++, bit++){
+                if (cells[j] == Cell::ALIVE){
+                    bits[bit / 8] |= (1 << (bit % 8));
+                }
+            }
+        }
+        outFile.write(reinterpret_cast<const char *>(bits.data()), bits.size());
+
+        outFile.close();
+        if (!outFile){
+            throw std::runtime_error("Could not write the checkpoint to file");
+        }
+    }
+
+    //The contents have to be on the disk before the rename is, or a power cut could leave an empty checkpoint
+    if (!sync_to_disk(temporary, false)){
+        throw std::runtime_error("Could not sync the checkpoint to disk");
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0){
+        throw std::runtime_error("Could not move the checkpoint into place");
+    }
+    const std::size_t slash = path.find_last_of('/');
+    const std::string directory = (slash == std::string::npos) ? "." : (slash == 0) ? "/" : path.substr(0, slash);
+    if (!sync_to_disk(directory, true)){
+        throw std::runtime_error("Could not sync the checkpoint's directory to disk");
+    }
+}
+
+/**
+ * Checkpointer::load(path, generation)
+ *
+ * Load a checkpoint file written by Checkpointer::save.
+ *
+ * @example
+ *
+ *      // Resume a run from its last checkpoint
+ *      std::uint64_t generation = 0;
+ *      World world(Checkpointer::load("run.ckpt", generation));
+ *
+ * @param path
+ *      The std::string path to the checkpoint file.
+ *
+ * @param generation
+ *      Set to the generation number stored in the checkpoint.
+ *
+ * @return
+ *      Returns the grid stored in the checkpoint.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if:
+ *          - The file cannot be opened.
+ *          - The file is not a checkpoint.
+ *          - The file ends unexpectedly.
+ */
+Grid Checkpointer::load(const std::string& path, std::uint64_t& generation) {
+    std::ifstream inFile(path, std::ios::in | std::ios::binary);
+    if (!inFile.is_open()){
+        throw std::runtime_error("File with that name could not be opened");
+    }
+
+    char file_magic[sizeof(magic)];
+    std::uint64_t file_generation = 0;
+    std::uint64_t width = 0;
+    std::uint64_t height = 0;
+    inFile.read(file_magic, sizeof(file_magic));
+    inFile.read(reinterpret_cast<char *>(&file_generation), sizeof(file_generation));
+    inFile.read(reinterpret_cast<char *>(&width), sizeof(width));
+    inFile.read(reinterpret_cast<char *>(&height), sizeof(height));
+    if (!inFile || !std::equal(magic, magic + sizeof(magic), file_magic)){
+        throw std::runtime_error("File is not a checkpoint");
+    }
+
+    std::vector<unsigned char> bits((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    if (bits.size() < (width * height + 7) / 8){
+        throw std::runtime_error("Unexpected end to checkpoint file, please check input");
+    }
+
+    Grid state(width, height);
+    std::size_t bit = 0;
+    for (std::size_t i = 0; i < height; i++){
+        Cell *cells = state.row(i);
+        for (std::size_t j = 0; j < width; j++, bit++){
+            if ((bits[bit / 8] >> (bit % 8)) & 1){
+                cells[j] = Cell::ALIVE;
+            }
+        }
+    }
+
+    generation = file_generation;
+    return state;
+}
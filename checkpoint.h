@@ -0,0 +1,70 @@
+/**
+ * Declares a class for periodically saving the state of a long running simulation so it can be resumed.
+ * Rich documentation for the api and behaviour the Checkpointer class can be found in checkpoint.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "grid.h"
+
+/**
+ * Declare the structure of the Checkpointer class for writing snapshots of a world on a background thread.
+ *
+ * Snapshots are double buffered: the stepping thread copies into the pending buffer while the writer
+ * thread serialises the other one, so stepping never waits on the disk.
+ */
+class Checkpointer {
+private:
+    //Where checkpoints are written and how often
+    std::string path;
+    unsigned int every_steps;
+    std::chrono::steady_clock::duration every_duration;
+
+    //When and at which generation the last snapshot was taken
+    std::chrono::steady_clock::time_point last_time;
+    std::uint64_t last_generation;
+
+    //The snapshot waiting to be written, only touched while holding the mutex
+    Grid pending;
+    std::uint64_t pending_generation;
+    bool has_pending;
+    bool writing;
+    bool stopping;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable written;
+    std::thread worker;
+
+    //The body of the background writer thread
+    void run();
+
+public:
+    //Checkpoints every N generations, every T seconds, or both. A value of 0 disables that trigger
+    //A run resumed from a checkpoint passes the generation it resumed at as first_generation
+    Checkpointer(const std::string& path, unsigned int every_steps, double every_seconds = 0,
+                 std::uint64_t first_generation = 0);
+    ~Checkpointer();
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    //Called after every step, takes a snapshot if one is due and returns whether it did
+    bool update(const Grid& state, std::uint64_t generation);
+
+    //Takes a snapshot straight away and waits for all snapshots to be written
+    void checkpoint(const Grid& state, std::uint64_t generation);
+    void flush();
+
+    //Synchronously reading and writing the checkpoint file format
+    static void save(const std::string& path, const Grid& state, std::uint64_t generation);
+    static Grid load(const std::string& path, std::uint64_t& generation);
+};
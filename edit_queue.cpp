@@ -0,0 +1,264 @@
+/**
+ * Implements a lock-free queue of edits that any number of threads can send to a world while it is being stepped.
+ *      - Pushing an edit is a single compare and swap onto the head of a linked stack, so producers never block
+ *        each other or the stepper.
+ *      - The stepper takes the whole stack with one atomic exchange, then sorts the batch by source and
+ *        sequence number. How the producer threads happened to interleave therefore never changes the result.
+ *      - Edits are applied between generations, never during one, so a step always sees a consistent grid.
+ *      - Edits that would not fit within the grid are dropped rather than stopping the simulation.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "edit_queue.h"
+#include <algorithm>
+#include <utility>
+#include "grid_view.h"
+
+/**
+ * EditQueue::EditQueue()
+ *
+ * Construct an empty queue.
+ *
+ * @example
+ *
+ *      // Let a bot drop gliders into a running world
+ *      EditQueue edits;
+ *      world.set_edit_queue(&edits);
+ *
+ *      std::thread bot([&edits]() {
+ *          EditQueue::Source source(edits, 1);
+ *          source.stamp(Zoo::glider(), 10, 10);
+ *      });
+ *
+ *      world.advance(1000);
+ */
+EditQueue::EditQueue() : head(nullptr){}
+
+/**
+ * EditQueue::~EditQueue()
+ *
+ * Destroy the queue, along with any edits still waiting in it.
+ */
+EditQueue::~EditQueue() {
+    free_nodes(head.exchange(nullptr));
+}
+
+/**
+ * EditQueue::free_nodes(node)
+ *
+ * Private helper that deletes a list of nodes.
+ */
+void EditQueue::free_nodes(Node *node) {
+    while (node != nullptr){
+        Node *next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+/**
+ * EditQueue::push(edit)
+ *
+ * Queue an edit. Safe to call from any number of threads at once, and never blocks.
+ *
+ * @param edit
+ *      The edit to queue. Its source and sequence decide where it goes in the batch it is applied in.
+ */
+void EditQueue::push(Edit edit) {
+    Node *node = new Node{std::move(edit), head.load(std::memory_order_relaxed)};
+    while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)){
+        //node->next has been updated to the current head, just try again
+    }
+}
+
+/**
+ * EditQueue::empty()
+ *
+ * @return
+ *      Whether there are no edits waiting. Another thread may push one straight after.
+ */
+bool EditQueue::empty() const {
+    return head.load(std::memory_order_acquire) == nullptr;
+}
+
+/**
+ * EditQueue::drain()
+ *
+ * Take every edit queued so far, to be called only from the thread stepping the world.
+ *
+ * @return
+ *      The edits, ordered by source and then by sequence number. The reference is valid until the next drain.
+ */
+const std::vector<EditQueue::Edit>& EditQueue::drain() {
+    batch.clear();
+    Node *node = head.exchange(nullptr, std::memory_order_acquire);
+    for (Node *current = node; current != nullptr; current = current->next){
+        batch.push_back(std::move(current->edit));
+    }
+    free_nodes(node);
+
+    std::sort(batch.begin(), batch.end(), [](const Edit &a, const Edit &b) {
+        return (a.source != b.source) ? a.source < b.source : a.sequence < b.sequence;
+    });
+    return batch;
+}
+
+/**
+ * EditQueue::apply(grid)
+ *
+ * Take every edit queued so far and apply them to a grid in order, to be called only from the thread stepping
+ * the world, between generations. Clears are clipped to the grid, sets and stamps that do not fit are dropped.
+ *
+ * @param grid
+ *      The grid to edit.
+ *
+ * @return
+ *      The number of edits applied.
+ */
+std::size_t EditQueue::apply(Grid &grid) {
+    if (empty()){
+        return 0;
+    }
+
+    const std::size_t width = grid.get_width();
+    const std::size_t height = grid.get_height();
+    std::size_t applied = 0;
+    for (const Edit &edit : drain()){
+        switch (edit.kind){
+            case Edit::Kind::Set:
+                if (edit.x < width && edit.y < height){
+                    grid.set(edit.x, edit.y, edit.value, Grid::unchecked);
+                    applied++;
+                }
+                break;
+            case Edit::Kind::Stamp:
+                if (edit.pattern && edit.pattern->get_width() <= width && edit.x <= width - edit.pattern->get_width() &&
+                    edit.pattern->get_height() <= height && edit.y <= height - edit.pattern->get_height()){
+                    grid.merge(edit.pattern->view(), edit.x, edit.y, edit.alive_only);
+                    applied++;
+                }
+                break;
+            case Edit::Kind::Clear: {
+                const std::size_t x1 = std::min(edit.x1, width);
+                const std::size_t y1 = std::min(edit.y1, height);
+                for (std::size_t y = edit.y; y < y1; y++){
+                    if (edit.x < x1){
+                        Cell *row = grid.row(y, Grid::unchecked);
+                        std::fill(row + edit.x, row + x1, Cell::DEAD);
+                    }
+                }
+                applied++;
+                break;
+            }
+        }
+    }
+    return applied;
+}
+
+/**
+ * EditQueue::Source::Source(queue, id)
+ *
+ * Construct a source of edits. Each producer should have its own id, which decides the order batches of edits
+ * from different producers are applied in, lower ids first.
+ *
+ * @param queue
+ *      The queue to send edits to, which must outlive the source.
+ *
+ * @param id
+ *      The id of this source.
+ */
+EditQueue::Source::Source(EditQueue &queue, const std::uint32_t id) : queue(&queue), id(id), sequence(0){}
+
+/**
+ * EditQueue::Source::get_id()
+ *
+ * @return
+ *      The id of this source.
+ */
+std::uint32_t EditQueue::Source::get_id() const {
+    return id;
+}
+
+/**
+ * EditQueue::Source::send(edit)
+ *
+ * Private helper that stamps an edit with this source's id and next sequence number and queues it.
+ */
+void EditQueue::Source::send(Edit edit) {
+    edit.source = id;
+    edit.sequence = sequence++;
+    queue->push(std::move(edit));
+}
+
+/**
+ * EditQueue::Source::set(x, y, value)
+ *
+ * Queue setting a single cell.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @param value
+ *      The new value of the cell.
+ */
+void EditQueue::Source::set(const std::size_t x, const std::size_t y, const Cell value) {
+    send({Edit::Kind::Set, 0, 0, x, y, x + 1, y + 1, value, nullptr, false});
+}
+
+/**
+ * EditQueue::Source::stamp(pattern, x, y, alive_only = true)
+ *
+ * Queue stamping a pattern, shared so the same pattern can be stamped many times without copying it.
+ *
+ * @param pattern
+ *      The pattern to stamp.
+ *
+ * @param x
+ *      The x coordinate to place the top left corner of the pattern at.
+ *
+ * @param y
+ *      The y coordinate to place the top left corner of the pattern at.
+ *
+ * @param alive_only
+ *      Optional parameter. If true only the alive cells of the pattern are stamped. Defaults to true.
+ */
+void EditQueue::Source::stamp(std::shared_ptr<const Grid> pattern, const std::size_t x, const std::size_t y,
+                              const bool alive_only) {
+    const std::size_t x1 = x + (pattern ? pattern->get_width() : 0);
+    const std::size_t y1 = y + (pattern ? pattern->get_height() : 0);
+    send({Edit::Kind::Stamp, 0, 0, x, y, x1, y1, Cell::DEAD, std::move(pattern), alive_only});
+}
+
+/**
+ * EditQueue::Source::stamp(pattern, x, y, alive_only = true)
+ *
+ * Queue stamping a copy of a pattern.
+ */
+void EditQueue::Source::stamp(const Grid& pattern, const std::size_t x, const std::size_t y, const bool alive_only) {
+    stamp(std::make_shared<const Grid>(pattern), x, y, alive_only);
+}
+
+/**
+ * EditQueue::Source::clear(x0, y0, x1, y1)
+ *
+ * Queue clearing every cell in the range [x0, x1) by [y0, y1), clipped to the grid.
+ *
+ * @param x0
+ *      Left coordinate of the region.
+ *
+ * @param y0
+ *      Top coordinate of the region.
+ *
+ * @param x1
+ *      Right coordinate of the region (1 greater than the largest index).
+ *
+ * @param y1
+ *      Bottom coordinate of the region (1 greater than the largest index).
+ */
+void EditQueue::Source::clear(const std::size_t x0, const std::size_t y0, const std::size_t x1, const std::size_t y1) {
+    send({Edit::Kind::Clear, 0, 0, x0, y0, x1, y1, Cell::DEAD, nullptr, false});
+}
@@ -0,0 +1,99 @@
+/**
+ * Declares a lock-free queue of edits that any number of threads can send to a world while it is being stepped.
+ * Rich documentation for the api and behaviour of the EditQueue class can be found in edit_queue.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "grid.h"
+
+/**
+ * Declare the structure of the EditQueue class, a multi-producer single-consumer queue of edits to a grid.
+ *
+ * Producers push edits without ever taking a lock. The thread stepping the world takes everything queued in one
+ * go between generations and applies it in a deterministic order: by source, then by the order each source
+ * sent them.
+ */
+class EditQueue {
+public:
+    //A single edit, setting a cell, stamping a pattern with its top left corner at x, y, or clearing [x, x1) by [y, y1)
+    struct Edit {
+        enum class Kind : unsigned char {
+            Set,
+            Stamp,
+            Clear
+        };
+
+        Kind kind;
+        std::uint32_t source;
+        std::uint64_t sequence;
+        std::size_t x;
+        std::size_t y;
+        std::size_t x1;
+        std::size_t y1;
+        Cell value;
+        std::shared_ptr<const Grid> pattern;
+        bool alive_only;
+    };
+
+    /**
+     * Declare the structure of the EditQueue::Source class, the handle a producer sends its edits through.
+     * Each source numbers its own edits, so it must only be used from one thread at a time.
+     */
+    class Source {
+    private:
+        EditQueue *queue;
+        std::uint32_t id;
+        std::uint64_t sequence;
+
+        void send(Edit edit);
+
+    public:
+        Source(EditQueue &queue, std::uint32_t id);
+
+        std::uint32_t get_id() const;
+
+        void set(std::size_t x, std::size_t y, Cell value);
+        void stamp(std::shared_ptr<const Grid> pattern, std::size_t x, std::size_t y, bool alive_only = true);
+        void stamp(const Grid& pattern, std::size_t x, std::size_t y, bool alive_only = true);
+        void clear(std::size_t x0, std::size_t y0, std::size_t x1, std::size_t y1);
+    };
+
+private:
+    //Edits are pushed onto a singly linked stack, which the consumer takes in one exchange
+    struct Node {
+        Edit edit;
+        Node *next;
+    };
+
+    std::atomic<Node *> head;
+
+    //Reused by every drain so that steady state needs no allocation on the consumer side
+    std::vector<Edit> batch;
+
+    static void free_nodes(Node *node);
+
+public:
+    EditQueue();
+    ~EditQueue();
+
+    EditQueue(const EditQueue&) = delete;
+    EditQueue& operator=(const EditQueue&) = delete;
+
+    //Pushes an edit from any thread, usually done through a Source
+    void push(Edit edit);
+    bool empty() const;
+
+    //Takes every queued edit, in the order they are applied in, the returned reference is valid until the next drain
+    const std::vector<Edit>& drain();
+
+    //Takes every queued edit and applies it to a grid, edits that do not fit within the grid are dropped
+    //Returns the number of edits applied
+    std::size_t apply(Grid &grid);
+};
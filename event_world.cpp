@@ -0,0 +1,302 @@
+/**
+ * Implements a class representing a 2d grid world that only does work around the cells that changed.
+ *      - The alive neighbour count of every cell is kept between steps instead of being recounted.
+ *      - Each step only applies the rules to cells next to, or equal to, a cell that changed in the previous
+ *        step. Nothing else can change, since its neighbourhood is exactly as it was.
+ *      - When a cell flips, the counts of its 8 neighbours go up or down by one.
+ *      - The results match World::step exactly, including how a toroidal topology wraps around, so stable
+ *        regions of a world cost nothing to step and a world that has settled down steps in almost no time.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "event_world.h"
+#include "kernel.h"
+
+/**
+ * EventWorld::EventWorld()
+ *
+ * Construct an empty world of size 0x0.
+ */
+EventWorld::EventWorld() : EventWorld(Grid()){}
+
+/**
+ * EventWorld::EventWorld(width, height)
+ *
+ * Construct a world with every cell dead.
+ *
+ * @param width
+ *      The width of the world.
+ *
+ * @param height
+ *      The height of the world.
+ */
+EventWorld::EventWorld(const std::size_t width, const std::size_t height) : EventWorld(Grid(width, height)){}
+
+/**
+ * EventWorld::EventWorld(initial_state, toroidal = false)
+ *
+ * Construct a world from an initial state and count the neighbours of every cell once.
+ *
+ * @example
+ *
+ *      // Step a large, mostly settled soup, paying only for the parts still moving
+ *      EventWorld world(Zoo::load_binary("soup.bgol"), true);
+ *      world.advance(10000, true);
+ *
+ * @param initial_state
+ *      The state of the world to start from.
+ *
+ * @param toroidal
+ *      Optional parameter. The topology to count neighbours for, which saves recounting them on the first
+ *      step if it matches. Defaults to false.
+ */
+EventWorld::EventWorld(const Grid& initial_state, const bool toroidal) : current_grid(initial_state), toroidal(toroidal) {
+    rebuild(toroidal);
+}
+
+template <typename Visit>
+void EventWorld::for_each_neighbour(const std::size_t x, const std::size_t y, Visit visit) const {
+    const std::size_t width = current_grid.get_width();
+    const std::size_t height = current_grid.get_height();
+    for (int i = -1; i < 2; i++){
+        for (int j = -1; j < 2; j++){
+            if (i == 0 && j == 0){
+                continue;
+            }
+
+            //Stepping one cell off an edge either wraps round to the far edge or leaves the grid
+            std::size_t nx = x + j;
+            std::size_t ny = y + i;
+            if (j < 0 && x == 0){
+                if (!toroidal){
+                    continue;
+                }
+                nx = width - 1;
+            } else if (j > 0 && x == width - 1){
+                if (!toroidal){
+                    continue;
+                }
+                nx = 0;
+            }
+            if (i < 0 && y == 0){
+                if (!toroidal){
+                    continue;
+                }
+                ny = height - 1;
+            } else if (i > 0 && y == height - 1){
+                if (!toroidal){
+                    continue;
+                }
+                ny = 0;
+            }
+            visit(nx, ny);
+        }
+    }
+}
+
+/**
+ * EventWorld::rebuild(toroidal)
+ *
+ * Private helper that counts the neighbours of every cell for the given topology, and puts every alive cell on
+ * the changed list since any cell that could change next step is next to one of them.
+ */
+void EventWorld::rebuild(const bool toroidal) {
+    this->toroidal = toroidal;
+    const std::size_t width = current_grid.get_width();
+    counts.assign(current_grid.get_total_cells(), 0);
+    changed.clear();
+
+    for (std::size_t y = 0; y < current_grid.get_height(); y++){
+        const Cell *row = current_grid.row(y, Grid::unchecked);
+        for (std::size_t x = 0; x < width; x++){
+            if (row[x] == Cell::ALIVE){
+                adjust_neighbours(x, y, 1);
+                changed.push_back({x, y});
+            }
+        }
+    }
+}
+
+/**
+ * EventWorld::adjust_neighbours(x, y, delta)
+ *
+ * Private helper that adds delta to the count of every neighbour of x, y. Neighbours that are the same cell
+ * more than once on a very narrow torus are adjusted more than once, exactly as World counts them.
+ */
+void EventWorld::adjust_neighbours(const std::size_t x, const std::size_t y, const int delta) {
+    const std::size_t width = current_grid.get_width();
+    for_each_neighbour(x, y, [&](const std::size_t nx, const std::size_t ny) {
+        counts[ny * width + nx] = static_cast<unsigned char>(counts[ny * width + nx] + delta);
+    });
+}
+
+/**
+ * EventWorld::get_width()
+ *
+ * @return
+ *      The width of the world.
+ */
+std::size_t EventWorld::get_width() const {
+    return current_grid.get_width();
+}
+
+/**
+ * EventWorld::get_height()
+ *
+ * @return
+ *      The height of the world.
+ */
+std::size_t EventWorld::get_height() const {
+    return current_grid.get_height();
+}
+
+/**
+ * EventWorld::get_total_cells()
+ *
+ * @return
+ *      The number of cells in the world.
+ */
+std::size_t EventWorld::get_total_cells() const {
+    return current_grid.get_total_cells();
+}
+
+/**
+ * EventWorld::get_alive_cells()
+ *
+ * @return
+ *      The number of alive cells in the current state.
+ */
+std::size_t EventWorld::get_alive_cells() const {
+    return current_grid.get_alive_cells();
+}
+
+/**
+ * EventWorld::get_dead_cells()
+ *
+ * @return
+ *      The number of dead cells in the current state.
+ */
+std::size_t EventWorld::get_dead_cells() const {
+    return current_grid.get_dead_cells();
+}
+
+/**
+ * EventWorld::get_state()
+ *
+ * @return
+ *      A read-only reference to the current state.
+ */
+const Grid& EventWorld::get_state() const {
+    return current_grid;
+}
+
+/**
+ * EventWorld::get_changed_cells()
+ *
+ * @return
+ *      How many cells changed in the last step, plus any set since. 0 means the world has stopped changing.
+ */
+std::size_t EventWorld::get_changed_cells() const {
+    return changed.size();
+}
+
+/**
+ * EventWorld::set(x, y, value)
+ *
+ * Set a single cell, updating the counts of its neighbours and marking it as changed so the next step looks
+ * at its neighbourhood.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @param value
+ *      The new value of the cell.
+ *
+ * @throws
+ *      std::out_of_range if x, y is not a valid coordinate within the world.
+ */
+void EventWorld::set(const std::size_t x, const std::size_t y, const Cell value) {
+    Cell &cell = current_grid(x, y);
+    if (cell == value){
+        return;
+    }
+    cell = value;
+    adjust_neighbours(x, y, (value == Cell::ALIVE) ? 1 : -1);
+    changed.push_back({x, y});
+}
+
+/**
+ * EventWorld::step(toroidal = false)
+ *
+ * Take one step in Conway's Game of Life, giving exactly the same result as World::step.
+ *
+ * Every cell in the neighbourhood of a changed cell becomes a candidate, once. The rules are applied to every
+ * candidate using the counts from before the step, then the cells that flipped are written and their
+ * neighbours' counts adjusted. The flipped cells are the changed list for the next step.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the step will consider the grid as a torus, where the left edge
+ *      wraps to the right edge and the top to the bottom. Changing the topology between steps recounts every
+ *      neighbour once. Defaults to false.
+ */
+void EventWorld::step(const bool toroidal) {
+    if (toroidal != this->toroidal){
+        rebuild(toroidal);
+    }
+    const std::size_t width = current_grid.get_width();
+
+    //Gather each cell next to or equal to a changed cell exactly once
+    candidates.clear();
+    auto enqueue = [&](const std::size_t x, const std::size_t y) {
+        unsigned char &count = counts[y * width + x];
+        if (!(count & queued)){
+            count |= queued;
+            candidates.push_back({x, y});
+        }
+    };
+    for (const Position &position : changed){
+        enqueue(position.x, position.y);
+        for_each_neighbour(position.x, position.y, enqueue);
+    }
+
+    //Decide every candidate from the counts as they were at the start of the step
+    flips.clear();
+    for (const Position &position : candidates){
+        unsigned char &count = counts[position.y * width + position.x];
+        count &= static_cast<unsigned char>(~queued);
+        const Cell cell = current_grid.get(position.x, position.y, Grid::unchecked);
+        if (Kernel::next_state(cell, count & count_mask) != cell){
+            flips.push_back(position);
+        }
+    }
+
+    //Then apply the flips and bring the counts up to date
+    for (const Position &position : flips){
+        Cell &cell = current_grid(position.x, position.y, Grid::unchecked);
+        cell = (cell == Cell::ALIVE) ? Cell::DEAD : Cell::ALIVE;
+        adjust_neighbours(position.x, position.y, (cell == Cell::ALIVE) ? 1 : -1);
+    }
+
+    changed.swap(flips);
+}
+
+/**
+ * EventWorld::advance(steps, toroidal = false)
+ *
+ * Advance multiple steps in the Game of Life.
+ *
+ * @param steps
+ *      The number of steps to advance the world forward.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the steps will consider the grid as a torus. Defaults to false.
+ */
+void EventWorld::advance(const std::size_t steps, const bool toroidal) {
+    for (std::size_t i = 0; i < steps; i++){
+        step(toroidal);
+    }
+}
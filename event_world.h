@@ -0,0 +1,77 @@
+/**
+ * Declares a class representing a 2d grid world that only does work around the cells that changed.
+ * Rich documentation for the api and behaviour the EventWorld class can be found in event_world.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <vector>
+#include "grid.h"
+
+/**
+ * Declare the structure of the EventWorld class, an event driven alternative to World.
+ *
+ * Alongside the cells an EventWorld keeps the number of alive neighbours of every cell and a list of the cells
+ * that changed in the last generation. A step only looks at the neighbourhoods of those cells, so the cost of a
+ * step is proportional to how much the world changes rather than how big it is.
+ */
+class EventWorld {
+private:
+    //A cell position, kept as a pair so chunked grids can be addressed a row at a time
+    struct Position {
+        std::size_t x;
+        std::size_t y;
+    };
+
+    Grid current_grid;
+
+    //The low four bits of each entry are the alive neighbour count of that cell, the queued bit marks cells
+    //already on the list of candidates for the step in progress
+    std::vector<unsigned char> counts;
+    static const unsigned char count_mask = 0x0F;
+    static const unsigned char queued = 0x10;
+
+    //Cells that changed since the last step, and the scratch lists reused by every step
+    std::vector<Position> changed;
+    std::vector<Position> candidates;
+    std::vector<Position> flips;
+
+    //The topology the counts were built for
+    bool toroidal;
+
+    //Recounts every neighbour from scratch and marks every alive cell as changed
+    void rebuild(bool toroidal);
+
+    //Adds delta to the count of every neighbour of x, y
+    void adjust_neighbours(std::size_t x, std::size_t y, int delta);
+
+    //Calls visit(nx, ny) for each of the 8 neighbours of x, y, wrapped or clipped to the grid like World
+    template <typename Visit>
+    void for_each_neighbour(std::size_t x, std::size_t y, Visit visit) const;
+
+public:
+    //Constructors that mirror those of the World class
+    EventWorld();
+    EventWorld(std::size_t width, std::size_t height);
+    explicit EventWorld(const Grid& initial_state, bool toroidal = false);
+
+    //Getters that mirror those of the World class
+    std::size_t get_width() const;
+    std::size_t get_height() const;
+    std::size_t get_total_cells() const;
+    std::size_t get_alive_cells() const;
+    std::size_t get_dead_cells() const;
+    const Grid& get_state() const;
+
+    //The number of cells that changed in the last step, or have been set since
+    std::size_t get_changed_cells() const;
+
+    //Changes a single cell, keeping the neighbour counts up to date
+    void set(std::size_t x, std::size_t y, Cell value);
+
+    //Steps the world, only visiting the neighbourhoods of changed cells
+    void step(bool toroidal = false);
+    void advance(std::size_t steps, bool toroidal = false);
+};
@@ -12,14 +12,355 @@
  * @date March, 2020
  */
 #include "grid.h"
+#include "grid_view.h"
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
 #include <iostream>
+#include <string>
+#include <cstring>
+#include <map>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // Include the minimal number of headers needed to support your implementation.
 // #include ...
 
+namespace {
+    //Grids up to this size are kept in one contiguous block, larger ones are split into chunks of at most this size
+    const std::size_t default_chunk_bytes = std::size_t(256) << 20;
+
+    //Works out how many rows go in each chunk of a width x height grid, as a power of two
+    unsigned int chunk_shift_for(const std::size_t width, const std::size_t height, const std::size_t chunk_bytes) {
+        if (width == 0 || height <= chunk_bytes / width){
+            //Everything fits in one chunk, so every row index maps to chunk 0
+            return sizeof(std::size_t) * 8 - 1;
+        }
+
+        //Otherwise take the largest power of two number of rows that fits, with at least one row per chunk
+        const std::size_t rows = std::max<std::size_t>(1, chunk_bytes / width);
+        unsigned int shift = 0;
+        while ((std::size_t(2) << shift) <= rows){
+            shift++;
+        }
+        return shift;
+    }
+
+    //The number of chunks needed to hold height rows with 2^shift rows per chunk
+    std::size_t chunk_count_for(const std::size_t height, const unsigned int shift) {
+        return (height == 0) ? 0 : ((height - 1) >> shift) + 1;
+    }
+}
+
+std::size_t CellStorage::chunk_bytes = default_chunk_bytes;
+
+/**
+ * CellStorage::CellStorage()
+ *
+ * Construct storage for an empty 0x0 grid.
+ */
+CellStorage::CellStorage() : CellStorage(0, 0){}
+
+/**
+ * CellStorage::CellStorage(width, height, resource = nullptr)
+ *
+ * Construct storage for a width x height grid with every cell dead. Grids no larger than
+ * CellStorage::get_chunk_bytes() are a single contiguous block, larger ones are allocated a chunk at a time
+ * so that no single allocation has to find billions of contiguous bytes.
+ *
+ * Memory comes from GridMemory, so large grids are backed by huge pages, and the cells are first written in
+ * parallel by GridMemory::for_each_band so each band of rows lives on the NUMA node of the thread stepping it.
+ *
+ * @param width
+ *      The width of the grid.
+ *
+ * @param height
+ *      The height of the grid.
+ *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate from, nullptr uses GridMemory::get_default_resource().
+ */
+CellStorage::CellStorage(const std::size_t width, const std::size_t height, std::pmr::memory_resource *resource) :
+        width(width),
+        height(height),
+        chunk_shift(chunk_shift_for(width, height, chunk_bytes)),
+        chunk_mask((std::size_t(1) << chunk_shift) - 1),
+        chunks(GridAllocator<Chunk>(resource)) {
+    const std::size_t count = chunk_count_for(height, chunk_shift);
+    const std::size_t rows_per_chunk = std::size_t(1) << chunk_shift;
+    chunks.reserve(count);
+    for (std::size_t i = 0; i < count; i++){
+        //The last chunk only holds the rows that are left over, the cells are not written to yet
+        const std::size_t rows = std::min(rows_per_chunk, height - i * rows_per_chunk);
+        chunks.emplace_back(rows * width, Chunk::allocator_type(chunks.get_allocator()));
+    }
+
+    //Each band of rows is first written by the thread that will step it, placing its pages on that thread's node
+    GridMemory::for_each_band(height, width, [this](const std::size_t first, const std::size_t last) {
+        for (std::size_t i = first; i < last; i++){
+            std::fill(row(i), row(i) + this->width, Cell::DEAD);
+        }
+    });
+}
+
+/**
+ * CellStorage::CellStorage(other)
+ *
+ * Copy the cells of other into new storage of the same shape, allocated from the default resource. Like newly
+ * constructed storage, each band of rows is copied by the thread that will step it so the copy's pages are
+ * placed on that thread's NUMA node.
+ *
+ * @param other
+ *      The storage to copy.
+ */
+CellStorage::CellStorage(const CellStorage& other) :
+        width(other.width),
+        height(other.height),
+        chunk_shift(other.chunk_shift),
+        chunk_mask(other.chunk_mask) {
+    chunks.reserve(other.chunks.size());
+    for (const auto& chunk : other.chunks){
+        chunks.emplace_back(chunk.size(), Chunk::allocator_type(chunks.get_allocator()));
+    }
+
+    GridMemory::for_each_band(height, width, [this, &other](const std::size_t first, const std::size_t last) {
+        for (std::size_t i = first; i < last; i++){
+            std::memcpy(row(i), other.row(i), width * sizeof(Cell));
+        }
+    });
+}
+
+/**
+ * CellStorage::get_width()
+ *
+ * @return
+ *      The number of cells in each row.
+ */
+std::size_t CellStorage::get_width() const {
+    return width;
+}
+
+/**
+ * CellStorage::get_height()
+ *
+ * @return
+ *      The number of rows.
+ */
+std::size_t CellStorage::get_height() const {
+    return height;
+}
+
+/**
+ * CellStorage::get_chunk_count()
+ *
+ * @return
+ *      The number of separately allocated chunks the rows are split over, 1 for a contiguous grid.
+ */
+std::size_t CellStorage::get_chunk_count() const {
+    return chunks.size();
+}
+
+/**
+ * CellStorage::get_resource()
+ *
+ * @return
+ *      The memory resource the cells are allocated from.
+ */
+std::pmr::memory_resource* CellStorage::get_resource() const {
+    return chunks.get_allocator().resource();
+}
+
+/**
+ * CellStorage::contiguous()
+ *
+ * Gets a pointer to every cell in row major order, which is only possible when the storage is a single chunk.
+ *
+ * @return
+ *      A pointer to the first cell, or nullptr if the storage is empty or split over several chunks.
+ */
+Cell* CellStorage::contiguous() {
+    return (chunks.size() == 1) ? chunks[0].data() : nullptr;
+}
+
+/**
+ * CellStorage::contiguous()
+ *
+ * Read-only version of CellStorage::contiguous().
+ *
+ * @return
+ *      A read-only pointer to the first cell, or nullptr if the storage is empty or split over several chunks.
+ */
+const Cell* CellStorage::contiguous() const {
+    return (chunks.size() == 1) ? chunks[0].data() : nullptr;
+}
+
+/**
+ * CellStorage::resize(new_width, new_height, preserve)
+ *
+ * Change the shape of the storage, keeping the cells in the region common to both shapes if preserve is true
+ * and filling every other cell with Cell::DEAD.
+ *
+ * While the storage stays within a single chunk the cells are rearranged in place within the existing block,
+ * which is reused whenever it is large enough. When the width shrinks the kept rows are moved up towards the
+ * front of the block in order, when it grows they are moved back from the last row to the first so no row is
+ * overwritten before it has been moved. Each row is moved with a single bulk copy and new cells are filled in
+ * bulk. Chunked storage is rebuilt in the new shape a row at a time instead.
+ *
+ * @param new_width
+ *      The new number of cells in each row.
+ *
+ * @param new_height
+ *      The new number of rows.
+ *
+ * @param preserve
+ *      If false the content is not kept and every cell is dead afterwards.
+ */
+void CellStorage::resize(const std::size_t new_width, const std::size_t new_height, const bool preserve) {
+    const unsigned int new_shift = chunk_shift_for(new_width, new_height, chunk_bytes);
+    const std::size_t kept_width = std::min(width, new_width);
+    const std::size_t kept_height = preserve ? std::min(height, new_height) : 0;
+
+    if (chunks.size() > 1 || chunk_count_for(new_height, new_shift) > 1){
+        //Moving between chunks, so build the new shape and copy the kept rows across
+        CellStorage resized(new_width, new_height, get_resource());
+        for (std::size_t i = 0; i < kept_height; i++){
+            std::memcpy(resized.row(i), row(i), kept_width * sizeof(Cell));
+        }
+        *this = std::move(resized);
+        return;
+    }
+
+    if (chunks.empty()){
+        chunks.emplace_back(Chunk::allocator_type(chunks.get_allocator()));
+    }
+    auto &block = chunks[0];
+    const std::size_t new_size = new_width * new_height;
+
+    if (new_width <= width){
+        //Rows only ever move towards the front, so move them in order, the first row is already in place
+        for (std::size_t i = 1; i < kept_height; i++){
+            std::memmove(&block[i * new_width], &block[i * width], kept_width * sizeof(Cell));
+        }
+        block.resize(std::max(block.size(), new_size));
+    } else {
+        //Rows move towards the back, so make room first then move them starting from the last row
+        block.resize(std::max(block.size(), new_size));
+        for (std::size_t i = kept_height; i-- > 0;){
+            Cell *dst = &block[i * new_width];
+            std::memmove(dst, &block[i * width], kept_width * sizeof(Cell));
+
+            //Pad the newly added columns on the end of the row
+            std::fill(dst + kept_width, dst + new_width, Cell::DEAD);
+        }
+    }
+
+    //Any rows below the kept region are new, as is anything past the end of the old grid
+    std::fill(block.begin() + kept_height * new_width, block.end(), Cell::DEAD);
+    block.resize(new_size);
+
+    width = new_width;
+    height = new_height;
+    chunk_shift = new_shift;
+    chunk_mask = (std::size_t(1) << chunk_shift) - 1;
+}
+
+/**
+ * CellStorage::grow(left, top, right, bottom)
+ *
+ * Expand the storage by a margin of dead cells on each side, keeping the current cells in the middle.
+ *
+ * Within a single chunk every row moves towards the back of the block, so rows are moved in place starting
+ * from the last one, each with a single bulk copy, and the margins are filled in bulk.
+ *
+ * @param left
+ *      The number of columns to add to the left edge.
+ *
+ * @param top
+ *      The number of rows to add to the top edge.
+ *
+ * @param right
+ *      The number of columns to add to the right edge.
+ *
+ * @param bottom
+ *      The number of rows to add to the bottom edge.
+ */
+void CellStorage::grow(const std::size_t left, const std::size_t top, const std::size_t right, const std::size_t bottom) {
+    const std::size_t new_width = width + left + right;
+    const std::size_t new_height = height + top + bottom;
+    const unsigned int new_shift = chunk_shift_for(new_width, new_height, chunk_bytes);
+
+    if (chunks.size() > 1 || chunk_count_for(new_height, new_shift) > 1){
+        //Moving between chunks, so build the new shape and copy every row across
+        CellStorage grown(new_width, new_height, get_resource());
+        for (std::size_t i = 0; i < height; i++){
+            std::memcpy(grown.row(i + top) + left, row(i), width * sizeof(Cell));
+        }
+        *this = std::move(grown);
+        return;
+    }
+
+    if (chunks.empty()){
+        chunks.emplace_back(Chunk::allocator_type(chunks.get_allocator()));
+    }
+    auto &block = chunks[0];
+
+    block.resize(new_width * new_height);
+    for (std::size_t i = height; i-- > 0;){
+        Cell *dst = &block[(i + top) * new_width];
+        std::memmove(dst + left, &block[i * width], width * sizeof(Cell));
+
+        //Clear the margins either side of the row
+        std::fill(dst, dst + left, Cell::DEAD);
+        std::fill(dst + left + width, dst + new_width, Cell::DEAD);
+    }
+
+    //Clear the margins above and below the content
+    std::fill(block.begin(), block.begin() + top * new_width, Cell::DEAD);
+    std::fill(block.begin() + (top + height) * new_width, block.end(), Cell::DEAD);
+
+    width = new_width;
+    height = new_height;
+    chunk_shift = new_shift;
+    chunk_mask = (std::size_t(1) << chunk_shift) - 1;
+}
+
+/**
+ * CellStorage::set_chunk_bytes(bytes)
+ *
+ * Set how large a grid can get before its cells are split into chunks, which is also the largest any one chunk
+ * will be. Only affects storage allocated afterwards, so should be set before any large grids are made.
+ *
+ * @example
+ *
+ *      // Split anything over 64MiB into 64MiB chunks
+ *      CellStorage::set_chunk_bytes(64 << 20);
+ *
+ * @param bytes
+ *      The largest a single chunk may be, in bytes.
+ *
+ * @throws
+ *      std::logic_error if bytes is 0.
+ */
+void CellStorage::set_chunk_bytes(const std::size_t bytes) {
+    if (bytes == 0){
+        throw std::logic_error("Chunks must be at least one byte");
+    }
+    chunk_bytes = bytes;
+}
+
+/**
+ * CellStorage::get_chunk_bytes()
+ *
+ * @return
+ *      The largest a single chunk may be, in bytes.
+ */
+std::size_t CellStorage::get_chunk_bytes() {
+    return chunk_bytes;
+}
+
 /**
  * Grid::Grid()
  *
@@ -32,7 +373,7 @@
  *      Grid grid;
  *
  */
-Grid::Grid() : width(0), height(0), total_cells(0), cell_grid(std::vector<Cell>()){}
+Grid::Grid() : width(0), height(0), total_cells(0), cells(){}
 
 /**
  * Grid::Grid(square_size)
@@ -59,13 +400,13 @@ Grid::Grid() : width(0), height(0), total_cells(0), cell_grid(std::vector<Cell>(
  */
 
 //Initialise all of the cells to be dead
-Grid::Grid(const unsigned int square_size) : width(square_size),
+Grid::Grid(const std::size_t square_size) : width(square_size),
                                              height(square_size),
                                              total_cells(square_size*square_size),
-                                             cell_grid(std::vector<Cell>(square_size * square_size, Cell::DEAD)){}
+                                             cells(square_size, square_size){}
 
 /**
- * Grid::Grid(width, height)
+ * Grid::Grid(width, height, resource = nullptr)
  *
  * Construct a grid with the desired size filled with dead cells.
  *
@@ -79,12 +420,17 @@ Grid::Grid(const unsigned int square_size) : width(square_size),
  *
  * @param height
  *      The height of the grid.
+ *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate the cells from, such as GridArena::resource().
+ *      Defaults to nullptr, which uses GridMemory::get_default_resource().
  */
  //Initialise all of the cells to be dead
-Grid::Grid(const unsigned int width, const unsigned int height) : width(width),
-                                                                  height(height),
-                                                                  total_cells(width * height),
-                                                                  cell_grid(std::vector<Cell>(width*height, Cell::DEAD)){}
+Grid::Grid(const std::size_t width, const std::size_t height, std::pmr::memory_resource *resource) :
+        width(width),
+        height(height),
+        total_cells(width * height),
+        cells(width, height, resource){}
 
 /**
  * Grid::get_width()
@@ -109,7 +455,7 @@ Grid::Grid(const unsigned int width, const unsigned int height) : width(width),
  * @return
  *      The width of the grid.
  */
-unsigned int Grid::get_width() const {
+std::size_t Grid::get_width() const {
     return width;
 }
 
@@ -136,7 +482,7 @@ unsigned int Grid::get_width() const {
  * @return
  *      The height of the grid.
  */
-unsigned int Grid::get_height() const {
+std::size_t Grid::get_height() const {
     return height;
 }
 
@@ -163,7 +509,7 @@ unsigned int Grid::get_height() const {
  * @return
  *      The number of total cells.
  */
-unsigned int Grid::get_total_cells() const {
+std::size_t Grid::get_total_cells() const {
     return total_cells;
 }
 
@@ -190,9 +536,12 @@ unsigned int Grid::get_total_cells() const {
  * @return
  *      The number of alive cells.
  */
-unsigned int Grid::get_alive_cells() const {
-    //Call std::cout on the cell vector, incrementing each time it finds an instance of Cell::ALIVE
-    unsigned int alive_count = std::count( this->cell_grid.begin(), this->cell_grid.end(), Cell::ALIVE);
+std::size_t Grid::get_alive_cells() const {
+    //Call std::count on each row, incrementing each time it finds an instance of Cell::ALIVE
+    std::size_t alive_count = 0;
+    for (std::size_t i = 0; i < height; i++){
+        alive_count += std::count(cells.row(i), cells.row(i) + width, Cell::ALIVE);
+    }
     return alive_count;
 }
 
@@ -219,11 +568,21 @@ unsigned int Grid::get_alive_cells() const {
  * @return
  *      The number of dead cells.
  */
-unsigned int Grid::get_dead_cells() const {
+std::size_t Grid::get_dead_cells() const {
     //The number of dead cells is simply the total number of cells minus the alive cells
     return total_cells - get_alive_cells();
 }
 
+/**
+ * Grid::get_resource()
+ *
+ * @return
+ *      The memory resource the cells of the grid are allocated from.
+ */
+std::pmr::memory_resource* Grid::get_resource() const {
+    return cells.get_resource();
+}
+
 /**
  * Grid::resize(square_size)
  *
@@ -241,17 +600,22 @@ unsigned int Grid::get_dead_cells() const {
  * @param square_size
  *      The new edge size for both the width and height of the grid.
  */
-void Grid::resize(const unsigned int new_square_size) {
+void Grid::resize(const std::size_t new_square_size) {
     //Call the other resize function with the width and height the dimensions of new_square_size
     Grid::resize(new_square_size, new_square_size);
 }
 
 /**
- * Grid::resize(width, height)
+ * Grid::resize(width, height, preserve = true)
  *
  * Resize the current grid to a new width and height. The content of the grid
  * should be preserved within the kept region and padded with Grid::DEAD if new cells are added.
  *
+ * The cells are rearranged in place within the existing storage, which is reused whenever it is large enough.
+ * When the width shrinks the kept rows are moved up towards the front of the storage in order, when it grows
+ * they are moved back from the last row to the first so no row is overwritten before it has been moved. Each
+ * row is moved with a single bulk copy and new cells are filled in bulk.
+ *
  * @example
  *
  *      // Make a grid
@@ -260,34 +624,22 @@ void Grid::resize(const unsigned int new_square_size) {
  *      // Resize the grid to be 2x8
  *      grid.resize(2, 8);
  *
+ *      // Resize it to be 16x16 without keeping anything, every cell is dead
+ *      grid.resize(16, 16, false);
+ *
  * @param new_width
  *      The new width for the grid.
  *
  * @param new_height
  *      The new height for the grid.
+ *
+ * @param preserve
+ *      Optional parameter. If false the content is not kept and every cell of the resized grid is dead,
+ *      which skips moving any rows. Defaults to true.
  */
-
- void Grid::resize(const unsigned int new_width, unsigned int const new_height) {
-     std::vector<Cell> resized;
-     //For each cell in the original grid
-     for (unsigned int i = 0; i < new_height; i++){
-         for(unsigned  int j = 0; j < new_width; j++){
-             //Ensures that we only attempt to index within the dimensions of the current grid
-             if ((j < width && i < height) && width != 0 && height != 0){
-                 //Index the grid at the current location
-                 unsigned int idx = get_index(i, j);
-                 //Add that cell to the new resized grid, since the new grid isn't initialised, we can just push back
-                 //values onto it
-                 resized.push_back(cell_grid.at(idx));
-             } else {
-                 //If either the new width or height is greater than the current, add on dead cells
-                 resized.push_back(Cell::DEAD);
-             }
-         }
-     }
-
-     //The resized grid is now correct and complete, we can now swap it out with the current grid
-     cell_grid.swap(resized);
+ void Grid::resize(const std::size_t new_width, std::size_t const new_height, const bool preserve) {
+     //The storage rearranges the rows itself
+     cells.resize(new_width, new_height, preserve);
 
      //Update all other member variables of the grid
      width = new_width;
@@ -296,24 +648,40 @@ void Grid::resize(const unsigned int new_square_size) {
  }
 
 /**
- * Grid::get_index(x, y)
+ * Grid::grow(left, top, right, bottom)
  *
- * Private helper function to determine the 1d index of a 2d coordinate.
- * Should not be visible from outside the Grid class.
- * The function should be callable from a constant context.
+ * Expand the grid by a margin of dead cells on each side, keeping the current content where it is relative to
+ * its neighbours. Useful for letting a world expand around its contents.
  *
- * @param x
- *      The x coordinate of the cell.
+ * Like Grid::resize this works in place: every row moves towards the back of the storage, so rows are moved
+ * starting from the last one, each with a single bulk copy, and the margins are filled in bulk.
  *
- * @param y
- *      The y coordinate of the cell.
+ * @example
  *
- * @return
- *      The 1d offset from the start of the data array where the desired cell is located.
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Add a border of 2 dead cells all the way round, making it 8x8 with the content in the middle
+ *      grid.grow(2, 2, 2, 2);
+ *
+ * @param left
+ *      The number of columns to add to the left edge.
+ *
+ * @param top
+ *      The number of rows to add to the top edge.
+ *
+ * @param right
+ *      The number of columns to add to the right edge.
+ *
+ * @param bottom
+ *      The number of rows to add to the bottom edge.
  */
-unsigned int Grid::get_index(const unsigned int x, const unsigned int y) const {
-    //Converts a 2D coordinate to a 1D coordinate, travel across the width y times then add the current x
-    return x + (width * y);
+void Grid::grow(const std::size_t left, const std::size_t top, const std::size_t right, const std::size_t bottom) {
+    cells.grow(left, top, right, bottom);
+
+    width = cells.get_width();
+    height = cells.get_height();
+    total_cells = width * height;
 }
 
 /**
@@ -332,6 +700,9 @@ unsigned int Grid::get_index(const unsigned int x, const unsigned int y) const {
  *      // Read the cell at coordinate (1, 2)
  *      Cell cell = grid.get(1, 2);
  *
+ *      // Read it again without the range check, for hot loops where the coordinate is known to be valid
+ *      Cell fast = grid.get(1, 2, Grid::unchecked);
+ *
  * @param x
  *      The x coordinate of the cell to update.
  *
@@ -344,7 +715,7 @@ unsigned int Grid::get_index(const unsigned int x, const unsigned int y) const {
  * @throws
  *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
  */
-Cell Grid::get(const unsigned int x, const unsigned int y) const {
+Cell Grid::get(const std::size_t x, const std::size_t y) const {
     //Try to return the value of the cell at x, y using operator(), or throw an exception
     try{
         return operator()(x, y);
@@ -368,6 +739,9 @@ Cell Grid::get(const unsigned int x, const unsigned int y) const {
  *      // Assign to a cell at coordinate (1, 2)
  *      grid.set(1, 2, Cell::ALIVE);
  *
+ *      // Assign to it again without the range check, for hot loops where the coordinate is known to be valid
+ *      grid.set(1, 2, Cell::DEAD, Grid::unchecked);
+ *
  * @param x
  *      The x coordinate of the cell to update.
  *
@@ -380,7 +754,7 @@ Cell Grid::get(const unsigned int x, const unsigned int y) const {
  * @throws
  *      std::exception or sub-class if x,y is not a valid coordinate within the grid.
  */
-void Grid::set(const unsigned int x, const unsigned int y, const Cell value){
+void Grid::set(const std::size_t x, const std::size_t y, const Cell value){
     //Try to update the value of a cell at /(x,y) using operator() or throw an exception for being out of bounds
     try {
         this -> operator()(x, y) = value;
@@ -394,7 +768,6 @@ void Grid::set(const unsigned int x, const unsigned int y, const Cell value){
  * Grid::operator()(x, y)
  *
  * Gets a modifiable reference to the value at the desired coordinate.
- * Should be implemented by invoking Grid::get_index(x, y).
  *
  * @example
  *
@@ -425,20 +798,13 @@ void Grid::set(const unsigned int x, const unsigned int y, const Cell value){
  * @throws
  *      std::runtime_error or sub-class if x,y is not a valid coordinate within the grid.
  */
- Cell& Grid::operator()(unsigned int x, unsigned int y) {
-    //Checks that the coordinates are valid
-    if ((0 <= x && x < get_width()) && (0 <= y && y < get_height())){
-        try {
-            //Get the modifiable reference of the cell at x, y using get_index
-            return cell_grid[get_index(x, y)];
-        } catch (const std::out_of_range& oor) {
-            //Handle the errors and prevent them for moving up the function call chain
-            std::cerr << "Out of range error thrown, (x, y) is not a valid grid coordinate: " << oor.what() << std::endl;
-            throw std::out_of_range("Cannot recover");
-        }
-    } else {
-        throw std::out_of_range("Incorrect values provided");
+ Cell& Grid::operator()(std::size_t x, std::size_t y) {
+    //Checks that the coordinates are valid, indexing the vector itself can then never throw
+    if (x < width && y < height){
+        //Get the modifiable reference of the cell at x, y within its row
+        return cells.row(y)[x];
     }
+    throw std::out_of_range("Incorrect values provided");
  }
 
 /**
@@ -446,7 +812,6 @@ void Grid::set(const unsigned int x, const unsigned int y, const Cell value){
  *
  * Gets a read-only reference to the value at the desired coordinate.
  * The operator should be callable from a constant context.
- * Should be implemented by invoking Grid::get_index(x, y).
  *
  * @example
  *
@@ -473,21 +838,80 @@ void Grid::set(const unsigned int x, const unsigned int y, const Cell value){
  */
 
 //Same at the operator() above but provides a non-modifiable reference
-const Cell& Grid::operator()(unsigned int x, unsigned int y) const {
-    if ((0 <= x && x < get_width()) && (0 <= y && y < get_height())){
-        try {
-            return cell_grid[get_index(x, y)];
-        } catch (const std::out_of_range& oor) {
-            std::cerr << "Out of range error thrown, (x, y) is not a valid grid coordinate: " << oor.what() << std::endl;
-            throw std::out_of_range("Cannot recover");
-        }
-    } else {
-        throw std::out_of_range("Incorrect values provided");
+const Cell& Grid::operator()(std::size_t x, std::size_t y) const {
+    if (x < width && y < height){
+        return cells.row(y)[x];
+    }
+    throw std::out_of_range("Incorrect values provided");
+}
+
+/**
+ * Grid::row(y)
+ *
+ * Gets a pointer to the width contiguous cells making up row y, so a whole row can be read or written in bulk.
+ * The unchecked overload Grid::row(y, Grid::unchecked) skips the range check for use in hot loops.
+ * Grid::data() gives the whole grid as width * height cells in row major order, but only for grids small
+ * enough to be stored in a single chunk, it is nullptr otherwise. Rows are always available through row(y).
+ * The pointer is invalidated if the grid is resized.
+ *
+ * @example
+ *
+ *      // Make a grid
+ *      Grid grid(4, 4);
+ *
+ *      // Bring the whole of row 2 to life
+ *      Cell *cells = grid.row(2);
+ *      std::fill(cells, cells + grid.get_width(), Cell::ALIVE);
+ *
+ *      // Count the alive cells without any per cell checks
+ *      std::size_t alive = 0;
+ *      for (std::size_t y = 0; y < grid.get_height(); y++) {
+ *          const Cell *r = grid.row(y, Grid::unchecked);
+ *          for (std::size_t x = 0; x < grid.get_width(); x++) {
+ *              alive += (r[x] == Cell::ALIVE);
+ *          }
+ *      }
+ *
+ * @param y
+ *      The y coordinate of the row.
+ *
+ * @return
+ *      A modifiable pointer to the first cell of the row.
+ *
+ * @throws
+ *      std::out_of_range if y is not a valid row within the grid.
+ */
+Cell* Grid::row(const std::size_t y) {
+    if (y < height){
+        return row(y, unchecked);
+    }
+    throw std::out_of_range("Incorrect values provided");
+}
+
+/**
+ * Grid::row(y)
+ *
+ * Gets a read-only pointer to the width contiguous cells making up row y.
+ * The function should be callable from a constant context.
+ *
+ * @param y
+ *      The y coordinate of the row.
+ *
+ * @return
+ *      A read-only pointer to the first cell of the row.
+ *
+ * @throws
+ *      std::out_of_range if y is not a valid row within the grid.
+ */
+const Cell* Grid::row(const std::size_t y) const {
+    if (y < height){
+        return row(y, unchecked);
     }
+    throw std::out_of_range("Incorrect values provided");
 }
 
 /**
- * Grid::crop(x0, y0, x1, y1)
+ * Grid::crop(x0, y0, x1, y1, resource = nullptr)
  *
  * Extract a sub-grid from a Grid.
  * The cropped grid spans the range [x0, x1) by [y0, y1) in the original grid.
@@ -513,6 +937,9 @@ const Cell& Grid::operator()(unsigned int x, unsigned int y) const {
  * @param y1
  *      Bottom coordinate of the crop window on y-axis (1 greater than the largest index).
  *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate the new grid from, defaults to the default resource.
+ *
  * @return
  *      A new grid of the cropped size containing the values extracted from the original grid.
  *
@@ -520,7 +947,8 @@ const Cell& Grid::operator()(unsigned int x, unsigned int y) const {
  *      std::exception or sub-class if x0,y0 or x1,y1 are not valid coordinates within the grid
  *      or if the crop window has a negative size.
  */
- Grid Grid::crop(const unsigned int x0, const unsigned int y0, const unsigned int x1, const unsigned int y1) const {
+ Grid Grid::crop(const std::size_t x0, const std::size_t y0, const std::size_t x1, const std::size_t y1,
+                 std::pmr::memory_resource *resource) const {
      //Errors fairly self explanatory
      try {
          if ((x0 <= x1) && (y0 <= y1)){
@@ -529,25 +957,8 @@ const Cell& Grid::operator()(unsigned int x, unsigned int y) const {
                  (0 <= y0 && y0 <= height) && (y0 <= y1 && y1 <= height)){
                  //If the coordinates are all valid
 
-                 //Create a new grid with the cropped dimensions
-                 Grid sub_grid((x1-x0), (y1-y0));
-
-                 //Create a buffer vector that can be swapped with
-                 std::vector<Cell> cropped;
-
-                 for (unsigned int i = y0; i < y1; i++){
-                     for (unsigned int j = x0; j < x1; j++){
-                         //For each value in the cropped area of the original grid, add it to the buffer vector
-                         //Get the cell by using the get method which converts a 2d coordinate to a 1d index
-                         cropped.push_back(this -> get(j, i));
-                     }
-                 }
-
-                 //Swap the buffer with the grid of the new cropped grid
-                 sub_grid.cell_grid.swap(cropped);
-
-                 //Return the cropped grid whilst not modifying the original grid
-                 return sub_grid;
+                 //Look at the window through a view and copy out just those cells, a row at a time
+                 return view(x0, y0, x1, y1).to_grid(resource);
              }
              throw std::out_of_range("One of more values not in range");
          }
@@ -563,6 +974,25 @@ const Cell& Grid::operator()(unsigned int x, unsigned int y) const {
      }
  }
 
+namespace {
+    //A dead cell is a space and an alive cell a hash, and as ' ' | '#' == '#' the bitwise or of two cells is alive
+    //exactly when either of them is. That lets alive only merges or whole rows together a byte at a time.
+    static_assert((Cell::DEAD | Cell::DEAD) == Cell::DEAD, "or-ing two dead cells must give a dead cell");
+    static_assert((Cell::DEAD | Cell::ALIVE) == Cell::ALIVE, "or-ing an alive cell in must give an alive cell");
+    static_assert((Cell::ALIVE | Cell::ALIVE) == Cell::ALIVE, "or-ing two alive cells must give an alive cell");
+
+    //Merges a contiguous span of cells onto another, either overwriting them or only bringing in alive cells
+    void merge_span(Cell *dst, const Cell *src, const std::size_t length, const bool alive_only) {
+        if (alive_only){
+            for (std::size_t i = 0; i < length; i++){
+                dst[i] = static_cast<Cell>(dst[i] | src[i]);
+            }
+        } else if (length != 0){
+            std::memmove(dst, src, length * sizeof(Cell));
+        }
+    }
+}
+
 /**
  * Grid::merge(other, x0, y0, alive_only = false)
  *
@@ -584,8 +1014,11 @@ const Cell& Grid::operator()(unsigned int x, unsigned int y) const {
  *      // Overlay x as the bottom right 2x2 in y, reading only alive cells from x
  *      y.merge(x, 2, 2, true);
  *
+ *      // Overlay x rotated by 90 degrees without making a rotated copy of it first
+ *      y.merge(x.view().rotate(1), 0, 2);
+ *
  * @param other
- *      The other grid to merge into the current grid.
+ *      The other grid, or view of a grid, to merge into the current grid.
  *
  * @param x0
  *      The x coordinate of where to place the top left corner of the other grid.
@@ -600,44 +1033,281 @@ const Cell& Grid::operator()(unsigned int x, unsigned int y) const {
  * @throws
  *      std::exception or sub-class if the other grid being placed does not fit within the bounds of the current grid.
  */
- void Grid::merge(const Grid &other, const unsigned int x0, const unsigned int y0, const bool alive_only) {
-     //Error handing fairly self explanatory
-     try {
-         //Iterate other the provided grid parameter
-         for (unsigned int i = 0; i < other.get_height(); i++){
-             for (unsigned int j = 0; j < other.get_width(); j++){
-                 //If only updating when alive
-                 if (alive_only){
-                     //If the cell of the provided grid at the current index is alive, then we overwrite the current grid
-                     //at that location with respect to where the other grid is placed on the current grid
-                     if (other.get(i, j) == Cell::ALIVE){
-                         this -> set(j+x0, i+y0, other.get(i, j));
-                     }
-                 } else {
-                     //When overwriting all values
-                     //Set the value of the current to that of the provided grid at the current index
-                     //Need to add x0 and y0 into the indexing such that we have respect to the location the other grid
-                     //is placed onto the current grid... confusing explanation I know
-                     this -> set(j+x0, i+y0, other.get(i, j));
-                 }
+ void Grid::merge(const GridView &other, const std::size_t x0, const std::size_t y0, const bool alive_only) {
+     //Check the whole of the other grid fits once up front, rather than bounds checking every cell
+     if (other.get_width() > width || x0 > width - other.get_width() ||
+         other.get_height() > height || y0 > height - other.get_height()){
+         std::cerr << "Out of range error thrown, the other grid does not fit within the bounds of the current grid"
+         << std::endl;
+         throw std::out_of_range("Cannot recover");
+     }
+
+     //Rotated or reflected views are not contiguous, so their rows are gathered into a buffer first
+     std::vector<Cell> gathered;
+     for (std::size_t i = 0; i < other.get_height(); i++){
+         const Cell *src = other.row(i);
+         if (src == nullptr){
+             gathered.resize(other.get_width());
+             for (std::size_t j = 0; j < other.get_width(); j++){
+                 gathered[j] = other(j, i);
              }
+             src = gathered.data();
          }
-     } catch (const std::out_of_range& oor){
-         std::cerr << "Out of range error thrown, the other grid does not fit within the bounds of the current grid: "
-         << oor.what() << std::endl;
-         throw std::out_of_range("Cannot recover");
+
+         //Need to add x0 and y0 into the indexing such that we have respect to the location the other grid
+         //is placed onto the current grid, then merge the whole row in one go
+         merge_span(cells.row(y0 + i) + x0, src, other.get_width(), alive_only);
      }
  }
 
+/**
+ * Grid::stamp_many(placements, alive_only = true, threads = 0)
+ *
+ * Merge a large batch of patterns into the grid at once, each placed at its own location and rotation.
+ *
+ * Each distinct pattern and rotation is only rotated once. The grid is then split into bands of rows, one per
+ * thread, and each thread stamps the rows of every placement that falls within its band. When overwriting,
+ * placements that overlap are applied in the order they appear in placements, exactly as if Grid::merge had
+ * been called for each of them in turn.
+ *
+ * @example
+ *
+ *      // Scatter a thousand gliders flying in every direction across a large grid
+ *      Grid grid(4096, 4096);
+ *      Grid glider = Zoo::glider();
+ *      std::vector<Grid::Placement> placements;
+ *      for (std::size_t i = 0; i < 1000; i++) {
+ *          placements.push_back({&glider, (i * 97) % 4090, (i * 131) % 4090, static_cast<int>(i % 4)});
+ *      }
+ *      grid.stamp_many(placements);
+ *
+ * @param placements
+ *      The patterns to stamp, each with the top left corner of where to place it after rotating it by
+ *      rotation quarter turns, following the convention of Grid::rotate.
+ *
+ * @param alive_only
+ *      Optional parameter. If true then only alive cells are stamped, as with Grid::merge. Defaults to true.
+ *
+ * @param threads
+ *      Optional parameter. The number of threads to stamp with, 0 uses one per hardware thread. Defaults to 0.
+ *
+ * @throws
+ *      std::exception or sub-class if any of the placed patterns does not fit within the bounds of the grid,
+ *      in which case nothing is stamped.
+ */
+void Grid::stamp_many(const std::vector<Placement> &placements, const bool alive_only, unsigned int threads) {
+    //Rotate each distinct pattern and rotation once, unrotated patterns are used as they are
+    //The rotated copies only live for this call, so they come from an arena that is freed in one go at the end
+    GridArena arena;
+    std::map<std::pair<const Grid *, int>, Grid> rotations;
+    std::vector<const Grid *> stamps(placements.size());
+    for (std::size_t i = 0; i < placements.size(); i++){
+        const int quarter_turns = ((placements[i].rotation % 4) + 4) % 4;
+        if (quarter_turns == 0){
+            stamps[i] = placements[i].pattern;
+        } else {
+            auto key = std::make_pair(placements[i].pattern, quarter_turns);
+            auto found = rotations.find(key);
+            if (found == rotations.end()){
+                found = rotations.emplace(key, placements[i].pattern->rotate(quarter_turns, arena.resource())).first;
+            }
+            stamps[i] = &found->second;
+        }
+
+        //Check every placement before stamping any of them
+        if (stamps[i]->width > width || placements[i].x > width - stamps[i]->width ||
+            stamps[i]->height > height || placements[i].y > height - stamps[i]->height){
+            std::cerr << "Out of range error thrown, placement " << i
+            << " does not fit within the bounds of the current grid" << std::endl;
+            throw std::out_of_range("Cannot recover");
+        }
+    }
+
+    //Sort the placements by their top row so each band can find the placements that reach into it
+    std::vector<std::size_t> by_row(placements.size());
+    std::size_t tallest = 0;
+    for (std::size_t i = 0; i < placements.size(); i++){
+        by_row[i] = i;
+        tallest = std::max(tallest, stamps[i]->height);
+    }
+    std::stable_sort(by_row.begin(), by_row.end(), [&placements](std::size_t a, std::size_t b) {
+        return placements[a].y < placements[b].y;
+    });
+
+    //Each band only ever writes to its own rows, so bands can be stamped concurrently without locking
+    auto stamp_band = [&](std::size_t band_start, std::size_t band_end) {
+        //Any placement reaching into the band starts at most tallest - 1 rows above it
+        const std::size_t first_row = (band_start >= tallest) ? band_start - tallest + 1 : 0;
+        auto begin = std::lower_bound(by_row.begin(), by_row.end(), first_row,
+                [&placements](std::size_t i, std::size_t row) { return placements[i].y < row; });
+        auto end = std::lower_bound(begin, by_row.end(), band_end,
+                [&placements](std::size_t i, std::size_t row) { return placements[i].y < row; });
+
+        std::vector<std::size_t> in_band;
+        for (auto it = begin; it != end; ++it){
+            if (placements[*it].y + stamps[*it]->height > band_start){
+                in_band.push_back(*it);
+            }
+        }
+
+        //Overlapping overwrites must land in their original order, merging alive cells is order independent
+        if (!alive_only){
+            std::sort(in_band.begin(), in_band.end());
+        }
+
+        for (std::size_t i : in_band){
+            const Grid &stamp = *stamps[i];
+            const std::size_t row_start = std::max(band_start, placements[i].y);
+            const std::size_t row_end = std::min(band_end, placements[i].y + stamp.height);
+            for (std::size_t row = row_start; row < row_end; row++){
+                merge_span(cells.row(row) + placements[i].x, stamp.cells.row(row - placements[i].y),
+                           stamp.width, alive_only);
+            }
+        }
+    };
+
+    if (threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(threads, height)));
+
+    std::vector<std::thread> workers;
+    const std::size_t band_rows = (height + threads - 1) / threads;
+    for (std::size_t band_start = 0; band_start < height; band_start += band_rows){
+        workers.emplace_back(stamp_band, band_start, std::min(height, band_start + band_rows));
+    }
+    for (std::thread &worker : workers){
+        worker.join();
+    }
+}
+
+
+/**
+ * Grid::view()
+ *
+ * Make a read-only view of the whole grid that can be cropped, rotated or reflected without copying any cells.
+ * The view is only valid while the grid is alive and has not been resized.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Print a grid upside down without making a rotated copy
+ *      Grid grid = Zoo::glider();
+ *      std::cout << grid.view().rotate(2).to_grid() << std::endl;
+ *
+ * @return
+ *      A view of the whole grid.
+ */
+GridView Grid::view() const {
+    return GridView(*this);
+}
+
+/**
+ * Grid::view(x0, y0, x1, y1)
+ *
+ * Make a read-only view of the window [x0, x1) by [y0, y1) of the grid, the zero copy counterpart of Grid::crop.
+ * The function should be callable from a constant context.
+ *
+ * @example
+ *
+ *      // Count the alive cells in the top left 100x100 of a large grid
+ *      std::size_t alive = grid.view(0, 0, 100, 100).get_alive_cells();
+ *
+ * @return
+ *      A view of the window.
+ *
+ * @throws
+ *      std::exception or sub-class if the window is not within the grid or has a negative size.
+ */
+GridView Grid::view(const std::size_t x0, const std::size_t y0, const std::size_t x1, const std::size_t y1) const {
+    return GridView(*this, x0, y0, x1, y1);
+}
+
+namespace {
+    //Rotations are done in blocks of block_size x block_size cells, so that both the rows being read and the rows
+    //being written stay in cache, and each block is moved as 8x8 tiles transposed entirely in registers
+    const std::size_t tile_size = 8;
+    const std::size_t block_size = 64;
+
+    //Transposes an 8x8 tile of cells, writing column k of the tile (read down rows[0] to rows[7]) to columns[k]
+    void transpose_tile(const Cell *const rows[tile_size], Cell *const columns[tile_size]) {
+#if defined(__SSE2__)
+        //Interleave bytes, then pairs, then quads, leaving two finished columns in each register
+        __m128i r[tile_size];
+        for (std::size_t i = 0; i < tile_size; i++){
+            r[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(rows[i]));
+        }
+        const __m128i a0 = _mm_unpacklo_epi8(r[0], r[1]), a1 = _mm_unpacklo_epi8(r[2], r[3]);
+        const __m128i a2 = _mm_unpacklo_epi8(r[4], r[5]), a3 = _mm_unpacklo_epi8(r[6], r[7]);
+        const __m128i b0 = _mm_unpacklo_epi16(a0, a1), b1 = _mm_unpackhi_epi16(a0, a1);
+        const __m128i b2 = _mm_unpacklo_epi16(a2, a3), b3 = _mm_unpackhi_epi16(a2, a3);
+        const __m128i c[4] = {_mm_unpacklo_epi32(b0, b2), _mm_unpackhi_epi32(b0, b2),
+                              _mm_unpacklo_epi32(b1, b3), _mm_unpackhi_epi32(b1, b3)};
+        for (std::size_t k = 0; k < 4; k++){
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(columns[2 * k]), c[k]);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(columns[2 * k + 1]), _mm_unpackhi_epi64(c[k], c[k]));
+        }
+#else
+        for (std::size_t k = 0; k < tile_size; k++){
+            for (std::size_t i = 0; i < tile_size; i++){
+                columns[k][i] = rows[i][k];
+            }
+        }
+#endif
+    }
+
+    //Rotates a width x height block of cells by 90 degrees clockwise, or anticlockwise, into dst in a single pass.
+    //Clockwise the cell at (x, y) ends up at (height - 1 - y, x), anticlockwise it ends up at (y, width - 1 - x).
+    void rotate_quarter(const CellStorage &src, CellStorage &dst, const std::size_t width, const std::size_t height,
+                        const bool clockwise) {
+        auto src_cell = [&](std::size_t x, std::size_t y) { return src.row(y) + x; };
+        auto dst_cell = [&](std::size_t x, std::size_t y) { return dst.row(y) + x; };
+
+        for (std::size_t by = 0; by < height; by += block_size){
+            for (std::size_t bx = 0; bx < width; bx += block_size){
+                const std::size_t y_end = std::min(height, by + block_size);
+                const std::size_t x_end = std::min(width, bx + block_size);
+
+                for (std::size_t y = by; y < y_end; y += tile_size){
+                    for (std::size_t x = bx; x < x_end; x += tile_size){
+                        if (y + tile_size <= y_end && x + tile_size <= x_end){
+                            //Clockwise, reading the rows bottom up means every column comes out already reversed
+                            const Cell *rows[tile_size];
+                            Cell *columns[tile_size];
+                            for (std::size_t k = 0; k < tile_size; k++){
+                                rows[k] = clockwise ? src_cell(x, y + tile_size - 1 - k) : src_cell(x, y + k);
+                                columns[k] = clockwise ? dst_cell(height - tile_size - y, x + k)
+                                                       : dst_cell(y, width - 1 - x - k);
+                            }
+                            transpose_tile(rows, columns);
+                        } else {
+                            //Partial tiles on the right and bottom edges are moved a cell at a time
+                            for (std::size_t i = y; i < std::min(y_end, y + tile_size); i++){
+                                for (std::size_t j = x; j < std::min(x_end, x + tile_size); j++){
+                                    Cell *out = clockwise ? dst_cell(height - 1 - i, j) : dst_cell(i, width - 1 - j);
+                                    *out = *src_cell(j, i);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
 
 /**
- * Grid::rotate(rotation)
+ * Grid::rotate(rotation, resource = nullptr)
  *
  * Create a copy of the grid that is rotated by a multiple of 90 degrees.
  * The rotation can be any integer, positive, negative, or 0.
  * The function should take the same amount of time to execute for any valid integer input.
  * The function should be callable from a constant context.
  *
+ * Every rotation is done in a single pass over the grid. 90 and 270 degree rotations are transposes, done in
+ * cache sized blocks of 8x8 tiles that are transposed in SSE2 registers where available. Use Grid::view() and
+ * GridView::rotate instead when the rotated cells only need to be read rather than copied.
+ *
  * @example
  *
  *      // Make a 1x3 grid
@@ -649,51 +1319,39 @@ const Cell& Grid::operator()(unsigned int x, unsigned int y) const {
  * @param _rotation
  *      An positive or negative integer to rotate by in 90 intervals.
  *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate the new grid from, defaults to the default resource.
+ *
  * @return
  *      Returns a copy of the grid that has been rotated.
  */
- Grid Grid::rotate(int _rotation) const {
-     //Create a copy of the current grid that is to be rotated
-     Grid to_rotate = *this;
-
-     //Need to check for backwards rotations too,
-     //Backwards basically means invert, so 90 = 270 and vice versa
-
-     //Converts negative rotations into the range needed, inverting -90 and -270 multiples
-     //Inverts 90 and 270 since a -90 rotation is a 270 and a -270 is a 90 rotation
-     if (_rotation < 0){
-         _rotation = abs(_rotation);
-         if ((_rotation -1) % 4 == 0){
-             _rotation = _rotation + 2;
-         } else if ((_rotation - 3) % 4 == 0){
-             _rotation = _rotation - 2;
+ Grid Grid::rotate(int _rotation, std::pmr::memory_resource *resource) const {
+     //Map any rotation, positive or negative, onto a number of clockwise quarter turns in the range [0, 4)
+     //A -90 rotation is the same as a 270 rotation and a -270 the same as a 90
+     const int quarter_turns = ((_rotation % 4) + 4) % 4;
+
+     //If rotation is a multiple of 4 or 0, return a copy of the original grid
+     if (quarter_turns == 0){
+         Grid rotated(width, height, resource);
+         for (std::size_t i = 0; i < height; i++){
+             std::memcpy(rotated.cells.row(i), cells.row(i), width * sizeof(Cell));
          }
+         return rotated;
      }
 
-     //If rotation is not a multiple of 4
-     if (_rotation % 4 != 0){
-         //If 90 or 270, (also -90 or -270)
-         if (((_rotation - 1) % 4 == 0) || ((_rotation - 3) % 4 == 0)){
-             //Rotating 90 degrees, flip the size of column and row
-             to_rotate.width = this -> height;
-             to_rotate.height = this -> width;
-             for (unsigned int i = 0; i < this -> height; i++){
-                 for (unsigned int j = 0; j < this -> width; j++){
-                     to_rotate.set((this -> height - 1 - i), j,this->operator()(j, i));
-                 }
-             }
-             // If rotating 270, simply rotate another 180 degrees
-             if ((_rotation - 3) % 4 == 0){
-                 std::reverse(to_rotate.cell_grid.begin(), to_rotate.cell_grid.end());
-             }
-         } else if ((_rotation - 2) % 4 == 0){
-             //Rotating 180 degrees, simply reverse the vector
-             std::reverse(to_rotate.cell_grid.begin(), to_rotate.cell_grid.end());
+     //Rotating 180 degrees, the cells are simply read backwards
+     if (quarter_turns == 2){
+         Grid rotated(width, height, resource);
+         for (std::size_t i = 0; i < height; i++){
+             std::reverse_copy(cells.row(i), cells.row(i) + width, rotated.cells.row(height - 1 - i));
          }
+         return rotated;
      }
 
-     //If rotation is a multiple of 4 or 0, return the original grid
-     return to_rotate;
+     //Rotating 90 or 270 degrees, flip the size of column and row and transpose in blocks
+     Grid rotated(height, width, resource);
+     rotate_quarter(cells, rotated.cells, width, height, quarter_turns == 1);
+     return rotated;
  }
 
 
@@ -733,47 +1391,29 @@ const Cell& Grid::operator()(unsigned int x, unsigned int y) const {
  *      Returns a reference to the output stream to enable operator chaining.
  */
 
-//Oh boy this was like doing some hackerrank stuff
 std::ostream& operator<<(std::ostream& os, const Grid &grid){
-    //Image we have a 1 cell border around our current grid, this increases the width and height by 2
-    for(unsigned int  i=0; i< grid.get_height()+2; i++) {
-        for (unsigned int j = 0; j < grid.get_width() + 2; j++) {
-            //If we are at the vertical border
-            if ((i == 0) || i == grid.get_height() + 1) {
-                //If we are at the left horizontal border, then top left + is placed
-                if (j == 0) {
-                    os << "+";
-                } else if (j == grid.get_width() + 1) {
-                    //Else if we are at the right horizontal border, the top right + is placed with a newline
-                    os << "+" << std::endl;
-                } else {
-                    //We are at the vertical border but not a corner so place a -
-                    os << "-";
-                }
-            //Not at the vertical border
-            } else {
-                //If at the left horizontal border
-                if (j == 0){
-                    //Place |
-                    os << "|";
-                //If at right horizontal border
-                } else if (j == grid.get_width() + 1){
-                    //Place | with new line
-                    os << "|" << std::endl;
-                } else {
-                    //Not on the border of the grid so we can just place the cell value, outputting ' ' or  '#'
-                    //given the cell value
-                    if (grid.operator()(j - 1, i - 1) == Cell::ALIVE){
-                        os << "#";
-                    } else {
-                        os << " ";
-                    }
-                }
-            }
-        }
+    //Build the whole frame in one buffer and hand it to the stream in a single write, rather than writing
+    //each character on its own and flushing at the end of every row
+    std::string frame;
+    frame.reserve((grid.width + 3) * (grid.height + 2));
+
+    //Top border, the corners are + and the edge is -
+    frame += '+';
+    frame.append(grid.width, '-');
+    frame += "+\n";
+
+    //The cell values are already the ' ' and '#' characters we want to print, so each row is copied across whole
+    for (std::size_t i = 0; i < grid.height; i++){
+        frame += '|';
+        frame.append(reinterpret_cast<const char *>(grid.cells.row(i)), grid.width);
+        frame += "|\n";
     }
 
+    //Bottom border matches the top
+    frame += '+';
+    frame.append(grid.width, '-');
+    frame += "+\n";
+
     //Return the finished stream output
-    return os;
+    return os.write(frame.data(), frame.size());
 }
-
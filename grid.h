@@ -11,8 +11,10 @@
 #pragma once
 
 // Add the minimal number of includes you need in order to declare the class.
+#include <cstddef>
 #include <vector>
 #include <iostream>
+#include "grid_memory.h"
 
 
 /**
@@ -23,56 +25,201 @@ enum Cell : char {
     ALIVE = '#'
 };
 
+//Declared in grid_view.h, a read-only window onto a grid that Grid can hand out and accept
+class GridView;
+
+/**
+ * Declare the structure of the CellStorage class that holds the cells of a Grid.
+ *
+ * Rows are grouped into chunks of a power of two number of rows, each chunk is a separate allocation and a row
+ * never straddles two chunks. Small grids fit in a single chunk and are one contiguous block, grids larger than
+ * CellStorage::get_chunk_bytes() are split so no single huge contiguous allocation is ever needed.
+ */
+class CellStorage {
+private:
+    std::size_t width;
+    std::size_t height;
+
+    //Row y lives in chunk y >> chunk_shift at row y & chunk_mask within it
+    unsigned int chunk_shift;
+    std::size_t chunk_mask;
+    using Chunk = std::vector<Cell, GridAllocator<Cell>>;
+    std::vector<Chunk, GridAllocator<Chunk>> chunks;
+
+    //The largest a single chunk is allowed to be, shared by all grids
+    static std::size_t chunk_bytes;
+
+public:
+    //Storage for a width x height grid of dead cells, from the GridMemory default resource unless one is given
+    CellStorage();
+    CellStorage(std::size_t width, std::size_t height, std::pmr::memory_resource *resource = nullptr);
+
+    //A copy is first touched in parallel bands just like new storage, and uses the default resource
+    //Copy assignment keeps the destination's resource and reuses its memory where the shapes allow
+    CellStorage(const CellStorage& other);
+    CellStorage(CellStorage&& other) noexcept = default;
+    CellStorage& operator=(const CellStorage& other) = default;
+    CellStorage& operator=(CellStorage&& other) noexcept = default;
+
+    std::size_t get_width() const;
+    std::size_t get_height() const;
+    std::size_t get_chunk_count() const;
+    std::pmr::memory_resource* get_resource() const;
+
+    //Gets a pointer to the width contiguous cells of row y, which is not checked
+    Cell* row(std::size_t y);
+    const Cell* row(std::size_t y) const;
+
+    //Gets a pointer to all of the cells in row major order, or nullptr if they are split over several chunks
+    Cell* contiguous();
+    const Cell* contiguous() const;
+
+    //Changes the shape of the storage, in place when it stays in a single chunk
+    void resize(std::size_t new_width, std::size_t new_height, bool preserve);
+    void grow(std::size_t left, std::size_t top, std::size_t right, std::size_t bottom);
+
+    //How large a grid can be before it is split into chunks, and so how large each chunk is
+    static void set_chunk_bytes(std::size_t bytes);
+    static std::size_t get_chunk_bytes();
+};
+
 /**
  * Declare the structure of the Grid class for representing a 2d grid of cells.
  */
 class Grid {
 private:
     //Private variables and methods of the Grid class
-    //A grid needs to store the width and height, the vector of cells it contains and the total number of cells
+    //A grid needs to store the width and height, the cells it contains and the total number of cells
     //Everything else can be computed inside member functions
-    unsigned int width;
-    unsigned int height;
-    unsigned int total_cells;
-    std::vector<Cell> cell_grid;
-
-    unsigned int get_index(unsigned int x, unsigned int y) const;
+    //Sizes are 64 bit so that worlds with billions of cells can be described without overflowing
+    std::size_t width;
+    std::size_t height;
+    std::size_t total_cells;
+    CellStorage cells;
 
 public:
+    //A pattern to stamp into the grid by Grid::stamp_many, with the top left corner placed at x, y after rotating it
+    struct Placement {
+        const Grid *pattern;
+        std::size_t x;
+        std::size_t y;
+        int rotation;
+    };
+
+    //Tag type selecting the unchecked overloads of the accessors, e.g. grid.get(x, y, Grid::unchecked)
+    struct Unchecked {};
+    static constexpr Unchecked unchecked{};
+
     //Public variables and methods of the Grid class
     //Three constructors, one for empty grid, one for square grid and one for width and height
+    //The cells come from the GridMemory default resource unless a resource such as a GridArena's is given
+    //A grid copied by construction uses the default resource, a grid copied into by assignment keeps its own
+    //resource and memory, and moving a grid keeps its resource
     Grid();
-    explicit Grid(unsigned int square_size);
-    Grid(unsigned int width, unsigned int height);
+    explicit Grid(std::size_t square_size);
+    Grid(std::size_t width, std::size_t height, std::pmr::memory_resource *resource = nullptr);
 
     //Getter methods
-    unsigned int get_width() const;
-    unsigned int get_height() const;
-    unsigned int get_total_cells() const;
-    unsigned int get_alive_cells() const;
-    unsigned int get_dead_cells() const;
-    Cell get(unsigned int x, unsigned int y) const;
+    std::size_t get_width() const;
+    std::size_t get_height() const;
+    std::size_t get_total_cells() const;
+    std::size_t get_alive_cells() const;
+    std::size_t get_dead_cells() const;
+    std::pmr::memory_resource* get_resource() const;
+    Cell get(std::size_t x, std::size_t y) const;
 
     //Sets the value of a cell at a provided location
-    void set(unsigned int x, unsigned int y, Cell value);
+    void set(std::size_t x, std::size_t y, Cell value);
 
     //Resizing method that can be called using a square size of a given height and width
-    void resize(unsigned int new_square_size);
-    void resize(unsigned int new_width, unsigned int new_height);
+    //Resizing happens in place, optionally without keeping the content at all
+    void resize(std::size_t new_square_size);
+    void resize(std::size_t new_width, std::size_t new_height, bool preserve = true);
+
+    //Expands the grid by a margin of dead cells on each side
+    void grow(std::size_t left, std::size_t top, std::size_t right, std::size_t bottom);
 
     //Get overloaded function call method, used for getting a reference to a cell value at a specified location
     //Can be called for a non-const or const context for either read only or writing to.
-    //Relies on the private get_index method and is used by get and set
-    Cell& operator()(unsigned int x, unsigned int y);
-    const Cell& operator()(unsigned int x, unsigned int y) const;
+    //Looks the row up in the cell storage and is used by get and set
+    Cell& operator()(std::size_t x, std::size_t y);
+    const Cell& operator()(std::size_t x, std::size_t y) const;
+
+    //Unchecked fast path accessors for hot loops, defined inline below so they compile down to a plain load or
+    //store. The caller promises x, y is a valid coordinate, nothing is checked and nothing is thrown.
+    Cell get(std::size_t x, std::size_t y, Unchecked) const;
+    void set(std::size_t x, std::size_t y, Cell value, Unchecked);
+    Cell& operator()(std::size_t x, std::size_t y, Unchecked);
+    const Cell& operator()(std::size_t x, std::size_t y, Unchecked) const;
+
+    //Raw access to the contiguous cells of row y, or of the whole grid in row major order
+    //The checked row accessors throw if y is out of range, the pointers are invalidated by resizing the grid
+    //data() is nullptr for grids large enough to be stored in several chunks, row(y) always works
+    Cell* row(std::size_t y);
+    const Cell* row(std::size_t y) const;
+    Cell* row(std::size_t y, Unchecked);
+    const Cell* row(std::size_t y, Unchecked) const;
+    Cell* data();
+    const Cell* data() const;
 
     //The methods used to manipulate the grid on a large scale, allowing a grid to be cropped, resized or merged with
     //other grids
-    Grid crop(unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1) const;
-    void merge(const Grid &other, unsigned int x0, unsigned int y0, bool alive_only = false);
-    Grid rotate(int _rotation) const;
+    //The new grids made by crop and rotate can be allocated from a given resource, so temporaries are cheap
+    Grid crop(std::size_t x0, std::size_t y0, std::size_t x1, std::size_t y1,
+              std::pmr::memory_resource *resource = nullptr) const;
+    void merge(const GridView &other, std::size_t x0, std::size_t y0, bool alive_only = false);
+    Grid rotate(int _rotation, std::pmr::memory_resource *resource = nullptr) const;
+
+    //Merges a large batch of patterns at once, in parallel over bands of rows
+    void stamp_many(const std::vector<Placement> &placements, bool alive_only = true, unsigned int threads = 0);
+
+    //Non-owning views of the whole grid or a window of it, which can then be rotated or reflected without copying
+    GridView view() const;
+    GridView view(std::size_t x0, std::size_t y0, std::size_t x1, std::size_t y1) const;
 
     //Overloaded friend << operator, used for outputting a grid to the screen using an ostream
     friend std::ostream& operator<<(std::ostream& os, const Grid &grid);
 };
 
+/*
+ * The unchecked accessors are defined here rather than in grid.cpp so they can be inlined into the caller's loop.
+ */
+inline Cell* CellStorage::row(const std::size_t y) {
+    return chunks[y >> chunk_shift].data() + (y & chunk_mask) * width;
+}
+
+inline const Cell* CellStorage::row(const std::size_t y) const {
+    return chunks[y >> chunk_shift].data() + (y & chunk_mask) * width;
+}
+
+inline Cell Grid::get(const std::size_t x, const std::size_t y, Unchecked) const {
+    return cells.row(y)[x];
+}
+
+inline void Grid::set(const std::size_t x, const std::size_t y, const Cell value, Unchecked) {
+    cells.row(y)[x] = value;
+}
+
+inline Cell& Grid::operator()(const std::size_t x, const std::size_t y, Unchecked) {
+    return cells.row(y)[x];
+}
+
+inline const Cell& Grid::operator()(const std::size_t x, const std::size_t y, Unchecked) const {
+    return cells.row(y)[x];
+}
+
+inline Cell* Grid::row(const std::size_t y, Unchecked) {
+    return cells.row(y);
+}
+
+inline const Cell* Grid::row(const std::size_t y, Unchecked) const {
+    return cells.row(y);
+}
+
+inline Cell* Grid::data() {
+    return cells.contiguous();
+}
+
+inline const Cell* Grid::data() const {
+    return cells.contiguous();
+}
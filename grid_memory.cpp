@@ -0,0 +1,673 @@
+/**
+ * Implements the allocation policy and memory resources used for the cells of every Grid.
+ *      - Every buffer is aligned to a cache line.
+ *      - Buffers of 2MB or more are mapped directly and backed by huge pages, either reserved 2MB / 1GB
+ *        hugetlbfs pages or transparent huge pages, so a big world needs far fewer TLB entries to step.
+ *        If no reserved huge pages are free the mapping quietly falls back to transparent huge pages.
+ *
+ *      - Physical pages are placed on the NUMA node of the thread that first writes to them. Grids are
+ *        filled by GridMemory::for_each_band using the same split of rows into bands that stepping uses,
+ *        and band i is always run by the same persistent worker, pinned to the i-th cpu the process may use.
+ *        So each band of both the current and next grid is first touched and then stepped from the same cpu,
+ *        and ends up in memory on that cpu's node.
+ *
+ *      - Grids are allocator aware through std::pmr. By default they come from a HugePageResource, but any
+ *        grid can be given its own resource. GridArena and GridPool wrap the standard monotonic and pooled
+ *        resources for batches of short lived grids, and CountingResource counts allocations so the cost of a
+ *        loop can be measured.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "grid_memory.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace {
+    std::atomic<HugePages> default_pages(HugePages::Transparent);
+    std::atomic<std::pmr::memory_resource *> default_resource(nullptr);
+    std::atomic<unsigned int> default_threads(0);
+
+    //Below this much work per band it is not worth starting threads
+    const std::size_t min_band_bytes = std::size_t(1) << 20;
+
+    //The size mappings of each page kind are rounded up to, which is also their alignment
+    std::size_t granule(const HugePages pages) {
+        return (pages == HugePages::Explicit1G) ? (std::size_t(1) << 30) : (std::size_t(2) << 20);
+    }
+
+    std::size_t round_up(const std::size_t bytes, const std::size_t to) {
+        return (bytes + to - 1) / to * to;
+    }
+
+    bool mapped(const std::size_t bytes, const HugePages pages) {
+        return pages != HugePages::None && bytes >= GridMemory::huge_threshold;
+    }
+
+#if defined(__linux__)
+    //Map anonymous memory aligned to a huge page and ask for it to be backed by transparent huge pages
+    void* map_transparent(const std::size_t length, const std::size_t align) {
+        //Over-map by one huge page then trim either end so the start is aligned
+        void *raw = mmap(nullptr, length + align, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED){
+            return nullptr;
+        }
+        char *start = static_cast<char *>(raw);
+        char *aligned = reinterpret_cast<char *>(round_up(reinterpret_cast<std::size_t>(start), align));
+        if (aligned != start){
+            munmap(start, aligned - start);
+        }
+        if (aligned + length != start + length + align){
+            munmap(aligned + length, (start + length + align) - (aligned + length));
+        }
+
+#if defined(MADV_HUGEPAGE)
+        //Only advice, if transparent huge pages are disabled this is still ordinary memory
+        madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+        return aligned;
+    }
+
+    //Map reserved hugetlbfs pages, nullptr if there are not enough free
+    void* map_explicit(const std::size_t length, const HugePages pages) {
+#if defined(MAP_HUGETLB)
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#if defined(MAP_HUGE_SHIFT)
+        flags |= ((pages == HugePages::Explicit1G) ? 30 : 21) << MAP_HUGE_SHIFT;
+#endif
+        void *raw = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+        return (raw == MAP_FAILED) ? nullptr : raw;
+#else
+        (void) length;
+        (void) pages;
+        return nullptr;
+#endif
+    }
+#endif
+
+    //The workers GridMemory::for_each_band runs bands on. Worker i is started once and pinned to the i-th cpu
+    //the process is allowed to run on, so band i of a grid is always touched and stepped from the same node
+    class BandWorkers {
+    private:
+        //Held by the call to for_each_band using the workers, other calls run their bands inline meanwhile
+        std::mutex busy;
+
+        //The current round of work, only touched while holding the mutex
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::vector<std::thread> threads;
+        const std::function<void(std::size_t, std::size_t)> *body = nullptr;
+        std::size_t rows = 0;
+        std::size_t bands = 0;
+        std::size_t remaining = 0;
+        std::uint64_t round = 0;
+        std::exception_ptr failure;
+
+        std::vector<int> cpus;
+
+        void run(const std::size_t index) {
+#if defined(__linux__)
+            if (!cpus.empty()){
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpus[index % cpus.size()], &set);
+                pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            }
+#endif
+            std::uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true){
+                wake.wait(lock, [&] { return round != seen; });
+                seen = round;
+                if (index >= bands){
+                    continue;
+                }
+
+                lock.unlock();
+                std::exception_ptr error;
+                try {
+                    (*body)(rows * index / bands, rows * (index + 1) / bands);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                lock.lock();
+
+                if (error && !failure){
+                    failure = error;
+                }
+                if (--remaining == 0){
+                    done.notify_one();
+                }
+            }
+        }
+
+    public:
+        BandWorkers() {
+#if defined(__linux__)
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0){
+                for (int cpu = 0; cpu < CPU_SETSIZE; cpu++){
+                    if (CPU_ISSET(cpu, &allowed)){
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+#endif
+        }
+
+        //Runs each band on its own worker and waits for them all, or returns false without running anything if
+        //another thread is using the workers, including a band calling for_each_band again
+        bool try_run(const std::size_t rows, const std::size_t bands,
+                     const std::function<void(std::size_t, std::size_t)>& body) {
+            std::unique_lock<std::mutex> using_workers(busy, std::try_to_lock);
+            if (!using_workers.owns_lock()){
+                return false;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            while (threads.size() < bands){
+                threads.emplace_back(&BandWorkers::run, this, threads.size());
+            }
+            this->body = &body;
+            this->rows = rows;
+            this->bands = bands;
+            remaining = bands;
+            failure = nullptr;
+            round++;
+            wake.notify_all();
+            done.wait(lock, [this] { return remaining == 0; });
+
+            this->body = nullptr;
+            if (failure){
+                std::rethrow_exception(failure);
+            }
+            return true;
+        }
+    };
+
+    //Deliberately leaked, its threads wait for work for the whole program
+    BandWorkers& band_workers() {
+        static BandWorkers *const workers = new BandWorkers();
+        return *workers;
+    }
+}
+
+/**
+ * GridMemory::allocate(bytes, pages)
+ *
+ * Allocate an uninitialised buffer aligned to a cache line. Buffers of at least GridMemory::huge_threshold bytes
+ * are mapped with the requested kind of huge page, smaller ones come from the heap.
+ *
+ * @param bytes
+ *      The size of the buffer.
+ *
+ * @param pages
+ *      The kind of pages to back a large buffer with.
+ *
+ * @return
+ *      A pointer to the buffer.
+ *
+ * @throws
+ *      std::bad_alloc if the memory cannot be allocated.
+ */
+void* GridMemory::allocate(const std::size_t bytes, const HugePages pages) {
+#if defined(__linux__)
+    if (mapped(bytes, pages)){
+        const std::size_t length = round_up(bytes, granule(pages));
+        void *buffer = nullptr;
+        if (pages == HugePages::Explicit2M || pages == HugePages::Explicit1G){
+            buffer = map_explicit(length, pages);
+        }
+        if (buffer == nullptr){
+            buffer = map_transparent(length, granule(pages));
+        }
+        if (buffer == nullptr){
+            throw std::bad_alloc();
+        }
+        return buffer;
+    }
+#endif
+    return ::operator new(bytes, std::align_val_t(alignment));
+}
+
+/**
+ * GridMemory::deallocate(pointer, bytes, pages)
+ *
+ * Free a buffer from GridMemory::allocate.
+ *
+ * @param pointer
+ *      The buffer to free.
+ *
+ * @param bytes
+ *      The size the buffer was allocated with.
+ *
+ * @param pages
+ *      The kind of pages the buffer was allocated with.
+ */
+void GridMemory::deallocate(void *pointer, const std::size_t bytes, const HugePages pages) {
+#if defined(__linux__)
+    if (mapped(bytes, pages)){
+        //Both kinds of mapping were made with the same rounded length
+        munmap(pointer, round_up(bytes, granule(pages)));
+        return;
+    }
+#endif
+    ::operator delete(pointer, std::align_val_t(alignment));
+}
+
+/**
+ * GridMemory::set_huge_pages(pages)
+ *
+ * Set the kind of pages grids allocated from now on are backed by, by making the huge page resource for that
+ * kind the default resource. Grids that already exist keep theirs.
+ *
+ * @example
+ *
+ *      // Use reserved 1GB pages for a huge world, after reserving them with
+ *      // echo 8 > /sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages
+ *      GridMemory::set_huge_pages(HugePages::Explicit1G);
+ *      World world(100000, 100000);
+ *
+ * @param pages
+ *      The kind of pages to use.
+ */
+void GridMemory::set_huge_pages(const HugePages pages) {
+    default_pages = pages;
+    default_resource = huge_page_resource(pages);
+}
+
+/**
+ * GridMemory::get_huge_pages()
+ *
+ * @return
+ *      The kind of pages new grids are backed by.
+ */
+HugePages GridMemory::get_huge_pages() {
+    return default_pages;
+}
+
+/**
+ * GridMemory::set_default_resource(resource)
+ *
+ * Set the resource grids are allocated from when they are not given one.
+ *
+ * @example
+ *
+ *      // Count every grid allocation made by a search
+ *      CountingResource counter;
+ *      GridMemory::set_default_resource(&counter);
+ *      run_search();
+ *      GridMemory::set_default_resource(nullptr);
+ *      std::cout << counter.get_allocations() << std::endl;
+ *
+ * @param resource
+ *      The new default resource, which must outlive every grid allocated from it. nullptr goes back to the
+ *      huge page resource for GridMemory::get_huge_pages().
+ */
+void GridMemory::set_default_resource(std::pmr::memory_resource *resource) {
+    default_resource = resource;
+}
+
+/**
+ * GridMemory::get_default_resource()
+ *
+ * @return
+ *      The resource grids are allocated from when they are not given one.
+ */
+std::pmr::memory_resource* GridMemory::get_default_resource() {
+    std::pmr::memory_resource *resource = default_resource;
+    return (resource != nullptr) ? resource : huge_page_resource(default_pages);
+}
+
+/**
+ * GridMemory::huge_page_resource(pages)
+ *
+ * @param pages
+ *      The kind of pages wanted.
+ *
+ * @return
+ *      The shared HugePageResource for that kind of page, which is never destroyed.
+ */
+std::pmr::memory_resource* GridMemory::huge_page_resource(const HugePages pages) {
+    //Deliberately leaked so grids in static storage can still free their memory during shutdown
+    static HugePageResource *const resources[] = {
+            new HugePageResource(HugePages::None),
+            new HugePageResource(HugePages::Transparent),
+            new HugePageResource(HugePages::Explicit2M),
+            new HugePageResource(HugePages::Explicit1G)
+    };
+    return resources[static_cast<unsigned char>(pages)];
+}
+
+/**
+ * GridMemory::set_threads(threads)
+ *
+ * Set how many threads grids are split between when they are first touched and stepped.
+ *
+ * @param threads
+ *      The number of threads, 0 uses one per hardware thread.
+ */
+void GridMemory::set_threads(const unsigned int threads) {
+    default_threads = threads;
+}
+
+/**
+ * GridMemory::get_threads()
+ *
+ * @return
+ *      The number of threads grids are split between, never 0.
+ */
+unsigned int GridMemory::get_threads() {
+    const unsigned int threads = default_threads;
+    if (threads != 0){
+        return threads;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * GridMemory::for_each_band(rows, row_bytes, body, threads = 0)
+ *
+ * Split rows [0, rows) into one contiguous band per thread, as evenly as possible, and call body(first, last)
+ * for each band [first, last) on its own thread. Band i always covers the same rows for a given number of
+ * rows and threads, and is always run by the same persistent worker pinned to the same cpu, so memory first
+ * touched through this ends up on the NUMA node of the cpu that later steps it.
+ *      - When there is too little work for every thread to get a worthwhile band, fewer bands are used.
+ *      - The workers serve one call at a time. A call made while they are busy, from another thread or from
+ *        inside a band, runs its bands one after another on the calling thread instead.
+ *      - The calling thread waits for every band to finish. If a band throws, the exception is rethrown here.
+ *
+ * @example
+ *
+ *      // Clear every row of a grid in parallel
+ *      GridMemory::for_each_band(grid.get_height(), grid.get_width(), [&](std::size_t first, std::size_t last) {
+ *          for (std::size_t i = first; i < last; i++) {
+ *              std::fill(grid.row(i), grid.row(i) + grid.get_width(), Cell::DEAD);
+ *          }
+ *      });
+ *
+ * @param rows
+ *      The number of rows to split.
+ *
+ * @param row_bytes
+ *      Roughly how much memory each row covers, used to decide whether threads are worthwhile.
+ *
+ * @param body
+ *      Called once per band with the first row and one past the last row of the band.
+ *
+ * @param threads
+ *      Optional parameter. The most bands to split the rows into, 0 for GridMemory::get_threads(). Only the same
+ *      count as grids are first touched with keeps each band on the node its memory is on. Defaults to 0.
+ */
+void GridMemory::for_each_band(const std::size_t rows, const std::size_t row_bytes,
+                               const std::function<void(std::size_t first, std::size_t last)>& body,
+                               const unsigned int threads) {
+    //Enough bands to keep every thread busy, but no band smaller than min_band_bytes or a single row
+    std::size_t bands = std::min<std::size_t>((threads != 0) ? threads : get_threads(), rows);
+    if (row_bytes != 0){
+        bands = std::min(bands, std::max<std::size_t>(1, rows * row_bytes / min_band_bytes));
+    }
+    if (bands <= 1){
+        if (rows != 0){
+            body(0, rows);
+        }
+        return;
+    }
+
+    if (!band_workers().try_run(rows, bands, body)){
+        //The workers are already busy with every core, so these bands just run in order
+        for (std::size_t i = 0; i < bands; i++){
+            body(rows * i / bands, rows * (i + 1) / bands);
+        }
+    }
+}
+
+/**
+ * HugePageResource::HugePageResource(pages)
+ *
+ * Construct a resource handing out memory from GridMemory::allocate. Usually the shared instance from
+ * GridMemory::huge_page_resource is used instead.
+ *
+ * @param pages
+ *      The kind of pages large allocations are backed by.
+ */
+HugePageResource::HugePageResource(const HugePages pages) : pages(pages){}
+
+/**
+ * HugePageResource::get_pages()
+ *
+ * @return
+ *      The kind of pages large allocations are backed by.
+ */
+HugePages HugePageResource::get_pages() const {
+    return pages;
+}
+
+void* HugePageResource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+    //GridMemory only promises a cache line, anything stricter goes straight to the heap
+    if (alignment > GridMemory::alignment){
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+    return GridMemory::allocate(bytes, pages);
+}
+
+void HugePageResource::do_deallocate(void *pointer, const std::size_t bytes, const std::size_t alignment) {
+    if (alignment > GridMemory::alignment){
+        ::operator delete(pointer, std::align_val_t(alignment));
+        return;
+    }
+    GridMemory::deallocate(pointer, bytes, pages);
+}
+
+bool HugePageResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    const auto *resource = dynamic_cast<const HugePageResource *>(&other);
+    return resource != nullptr && resource->pages == pages;
+}
+
+/**
+ * CountingResource::CountingResource(upstream = nullptr)
+ *
+ * Construct a resource that counts the requests passing through it.
+ *
+ * @example
+ *
+ *      // Count the allocations one iteration of a search makes
+ *      CountingResource counter;
+ *      for (auto& candidate : candidates) {
+ *          counter.reset_counts();
+ *          Grid rotated = candidate.rotate(1, &counter);
+ *          ...
+ *          std::cout << counter.get_allocations() << std::endl;
+ *      }
+ *
+ * @param upstream
+ *      Optional parameter. The resource that actually provides the memory, defaults to the GridMemory
+ *      default resource at the time of construction.
+ */
+CountingResource::CountingResource(std::pmr::memory_resource *upstream) :
+        upstream((upstream != nullptr) ? upstream : GridMemory::get_default_resource()),
+        allocations(0),
+        deallocations(0),
+        bytes_in_use(0),
+        peak_bytes(0){}
+
+/**
+ * CountingResource::get_allocations()
+ *
+ * @return
+ *      The number of allocations made since construction or the last CountingResource::reset_counts().
+ */
+std::size_t CountingResource::get_allocations() const {
+    return allocations;
+}
+
+/**
+ * CountingResource::get_deallocations()
+ *
+ * @return
+ *      The number of deallocations made since construction or the last CountingResource::reset_counts().
+ */
+std::size_t CountingResource::get_deallocations() const {
+    return deallocations;
+}
+
+/**
+ * CountingResource::get_bytes_in_use()
+ *
+ * @return
+ *      The number of bytes allocated and not yet freed.
+ */
+std::size_t CountingResource::get_bytes_in_use() const {
+    return bytes_in_use;
+}
+
+/**
+ * CountingResource::get_peak_bytes()
+ *
+ * @return
+ *      The most bytes that have been in use at once since construction or the last reset.
+ */
+std::size_t CountingResource::get_peak_bytes() const {
+    return peak_bytes;
+}
+
+/**
+ * CountingResource::reset_counts()
+ *
+ * Zero the allocation and deallocation counts and restart the peak from the bytes currently in use.
+ */
+void CountingResource::reset_counts() {
+    allocations = 0;
+    deallocations = 0;
+    peak_bytes = bytes_in_use.load();
+}
+
+void* CountingResource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+    void *pointer = upstream->allocate(bytes, alignment);
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    //Raise the peak if this allocation went past it
+    const std::size_t in_use = bytes_in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (in_use > peak && !peak_bytes.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)){}
+    return pointer;
+}
+
+void CountingResource::do_deallocate(void *pointer, const std::size_t bytes, const std::size_t alignment) {
+    upstream->deallocate(pointer, bytes, alignment);
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+    bytes_in_use.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+/**
+ * GridArena::GridArena(initial_bytes = 64KiB, upstream = nullptr)
+ *
+ * Construct an empty arena. Memory is taken from upstream in growing blocks as grids need it.
+ *
+ * @example
+ *
+ *      // Try every orientation of a pattern without touching the heap after the first iteration
+ *      GridArena arena;
+ *      for (int i = 0; i < 4; i++) {
+ *          Grid rotated = pattern.rotate(i, arena.resource());
+ *          ...
+ *      }
+ *      arena.release();
+ *
+ * @param initial_bytes
+ *      Optional parameter. The size of the first block taken from upstream, defaults to 64KiB.
+ *
+ * @param upstream
+ *      Optional parameter. Where the blocks come from, defaults to the GridMemory default resource.
+ */
+GridArena::GridArena(const std::size_t initial_bytes, std::pmr::memory_resource *upstream) :
+        counter(upstream),
+        arena(initial_bytes, &counter){}
+
+/**
+ * GridArena::resource()
+ *
+ * @return
+ *      The resource to allocate grids from.
+ */
+std::pmr::memory_resource* GridArena::resource() {
+    return &arena;
+}
+
+/**
+ * GridArena::release()
+ *
+ * Free every grid allocated from the arena in one go. None of them may be used afterwards.
+ */
+void GridArena::release() {
+    arena.release();
+}
+
+/**
+ * GridArena::get_upstream()
+ *
+ * @return
+ *      A read-only reference to the counts of blocks the arena has taken from upstream.
+ */
+const CountingResource& GridArena::get_upstream() const {
+    return counter;
+}
+
+/**
+ * GridPool::GridPool(upstream = nullptr)
+ *
+ * Construct an empty pool. Blocks are taken from upstream as needed and kept for reuse.
+ *
+ * @param upstream
+ *      Optional parameter. Where the blocks come from, defaults to the GridMemory default resource.
+ */
+GridPool::GridPool(std::pmr::memory_resource *upstream) :
+        counter(upstream),
+        pool(&counter){}
+
+/**
+ * GridPool::resource()
+ *
+ * @return
+ *      The resource to allocate grids from.
+ */
+std::pmr::memory_resource* GridPool::resource() {
+    return &pool;
+}
+
+/**
+ * GridPool::release()
+ *
+ * Hand every block back to upstream. None of the grids allocated from the pool may be used afterwards.
+ */
+void GridPool::release() {
+    pool.release();
+}
+
+/**
+ * GridPool::get_upstream()
+ *
+ * @return
+ *      A read-only reference to the counts of blocks the pool has taken from upstream.
+ */
+const CountingResource& GridPool::get_upstream() const {
+    return counter;
+}
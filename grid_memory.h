@@ -0,0 +1,220 @@
+/**
+ * Declares the allocation policy and memory resources used for the cells of every Grid.
+ * Rich documentation for the api and behaviour of the GridMemory namespace and the resource classes can be
+ * found in grid_memory.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * The kind of pages large cell buffers are backed by.
+ *      - None: ordinary heap memory.
+ *      - Transparent: 2MB aligned anonymous memory the kernel is asked to back with transparent huge pages.
+ *      - Explicit2M / Explicit1G: reserved hugetlbfs pages, falling back to Transparent when none are free.
+ */
+enum class HugePages : unsigned char {
+    None,
+    Transparent,
+    Explicit2M,
+    Explicit1G
+};
+
+/**
+ * Declare the interface of the GridMemory namespace for allocating cell buffers and placing their pages.
+ */
+namespace GridMemory {
+    //Every buffer starts on a cache line boundary
+    const std::size_t alignment = 64;
+
+    //Buffers smaller than this always come from the heap, larger ones follow the huge page policy
+    const std::size_t huge_threshold = std::size_t(2) << 20;
+
+    //Allocate and free a buffer, deallocate must be given the same size and page kind as allocate
+    void* allocate(std::size_t bytes, HugePages pages);
+    void deallocate(void *pointer, std::size_t bytes, HugePages pages);
+
+    //The page kind new grids are allocated with, transparent huge pages by default
+    //Setting it makes the huge page resource for that kind the default resource
+    void set_huge_pages(HugePages pages);
+    HugePages get_huge_pages();
+
+    //The resource grids are allocated from when none is given, nullptr restores the huge page resource
+    void set_default_resource(std::pmr::memory_resource *resource);
+    std::pmr::memory_resource* get_default_resource();
+
+    //One shared resource per kind of page, which live for the whole program
+    std::pmr::memory_resource* huge_page_resource(HugePages pages);
+
+    //How many threads first touch and step a grid, 0 means one per hardware thread
+    void set_threads(unsigned int threads);
+    unsigned int get_threads();
+
+    //Splits rows into one contiguous band per thread and runs body(first, last) on each band in parallel
+    //Small amounts of work run on the calling thread, so the split for a given grid is always the same
+    //0 threads means get_threads()
+    void for_each_band(std::size_t rows, std::size_t row_bytes,
+                       const std::function<void(std::size_t first, std::size_t last)>& body,
+                       unsigned int threads = 0);
+};
+
+/**
+ * Declare the structure of the HugePageResource class, a memory resource backed by GridMemory::allocate.
+ */
+class HugePageResource : public std::pmr::memory_resource {
+private:
+    HugePages pages;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+    explicit HugePageResource(HugePages pages);
+    HugePages get_pages() const;
+};
+
+/**
+ * Declare the structure of the CountingResource class, which passes every request on to another resource
+ * and counts them, so the number of allocations made by a piece of code can be measured.
+ */
+class CountingResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource *upstream;
+    std::atomic<std::size_t> allocations;
+    std::atomic<std::size_t> deallocations;
+    std::atomic<std::size_t> bytes_in_use;
+    std::atomic<std::size_t> peak_bytes;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+    explicit CountingResource(std::pmr::memory_resource *upstream = nullptr);
+
+    std::size_t get_allocations() const;
+    std::size_t get_deallocations() const;
+    std::size_t get_bytes_in_use() const;
+    std::size_t get_peak_bytes() const;
+
+    //Zeroes the allocation counts, for example at the start of each iteration of a loop
+    void reset_counts();
+};
+
+/**
+ * Declare the structure of the GridArena class, a monotonic arena for batches of short lived grids.
+ *
+ * Grids allocated from the arena only bump a pointer, freeing them does nothing, and release() hands all of
+ * the memory back in one go. Every grid allocated from the arena must be gone before it is released.
+ */
+class GridArena {
+private:
+    //Counts the blocks the arena takes from the upstream resource
+    CountingResource counter;
+    std::pmr::monotonic_buffer_resource arena;
+
+public:
+    explicit GridArena(std::size_t initial_bytes = std::size_t(64) << 10, std::pmr::memory_resource *upstream = nullptr);
+
+    std::pmr::memory_resource* resource();
+    void release();
+    const CountingResource& get_upstream() const;
+};
+
+/**
+ * Declare the structure of the GridPool class, a pool of reusable blocks for grids that come and go one at a time.
+ *
+ * Unlike GridArena, freeing a grid makes its memory available to the next grid of a similar size straight away.
+ * Pools are not thread safe, each thread should have its own.
+ */
+class GridPool {
+private:
+    //Counts the blocks the pool takes from the upstream resource
+    CountingResource counter;
+    std::pmr::unsynchronized_pool_resource pool;
+
+public:
+    explicit GridPool(std::pmr::memory_resource *upstream = nullptr);
+
+    std::pmr::memory_resource* resource();
+    void release();
+    const CountingResource& get_upstream() const;
+};
+
+/**
+ * Declare the GridAllocator class, a standard allocator that gets its memory from a std::pmr::memory_resource,
+ * by default the GridMemory default resource.
+ *
+ * Elements constructed without a value are left uninitialised, so resizing a buffer does not write to its
+ * pages. That leaves the first write to each page to whichever thread will go on to use it.
+ *
+ * Copying a container gives the copy the default resource, as std::pmr does, so a copy never outlives an arena
+ * by accident. Copy assigning into a container keeps the resource it already had, so its memory can be reused.
+ * Moving or swapping a container takes its resource with it.
+ */
+template <typename T>
+class GridAllocator {
+private:
+    template <typename U> friend class GridAllocator;
+
+    std::pmr::memory_resource *memory;
+
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    GridAllocator() : memory(GridMemory::get_default_resource()){}
+    explicit GridAllocator(std::pmr::memory_resource *resource) :
+            memory((resource != nullptr) ? resource : GridMemory::get_default_resource()){}
+    template <typename U>
+    GridAllocator(const GridAllocator<U>& other) : memory(other.memory){}
+
+    std::pmr::memory_resource* resource() const {
+        return memory;
+    }
+
+    GridAllocator select_on_container_copy_construction() const {
+        return GridAllocator();
+    }
+
+    T* allocate(std::size_t n) {
+        return static_cast<T *>(memory->allocate(n * sizeof(T), std::max(alignof(T), GridMemory::alignment)));
+    }
+
+    void deallocate(T *pointer, std::size_t n) {
+        memory->deallocate(pointer, n * sizeof(T), std::max(alignof(T), GridMemory::alignment));
+    }
+
+    //Default initialisation, which for cells means not touching the memory at all
+    template <typename U>
+    void construct(U *pointer) {
+        ::new (static_cast<void *>(pointer)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U *pointer, Args&&... args) {
+        ::new (static_cast<void *>(pointer)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    bool operator==(const GridAllocator<U>& other) const {
+        return memory == other.memory || memory->is_equal(*other.memory);
+    }
+
+    template <typename U>
+    bool operator!=(const GridAllocator<U>& other) const {
+        return !(*this == other);
+    }
+};
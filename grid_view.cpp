@@ -0,0 +1,304 @@
+/**
+ * Implements a class representing a read-only window onto a Grid that never copies any cells.
+ *      - Views can look at a whole grid or a rectangular window of it.
+ *      - Views can be cropped, rotated by multiples of 90 degrees and reflected left to right, in O(1) time
+ *        and memory, by composing index transforms rather than moving cells.
+ *      - Rotations follow exactly the same convention as Grid::rotate.
+ *      - Views can be turned back into a Grid when an owning copy is really needed.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "grid_view.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * GridView::GridView(grid)
+ *
+ * Construct a view of a whole grid. This constructor is deliberately not explicit, so any function taking
+ * a const GridView& can be handed a Grid directly.
+ *
+ * @example
+ *
+ *      // Look at a glider without copying it
+ *      Grid glider = Zoo::glider();
+ *      GridView view(glider);
+ *
+ * @param grid
+ *      The grid to look at, which must outlive the view.
+ */
+GridView::GridView(const Grid& grid) : grid(&grid),
+                                       width(grid.get_width()),
+                                       height(grid.get_height()),
+                                       origin_x(0),
+                                       origin_y(0),
+                                       xx(1), xy(0), yx(0), yy(1){}
+
+/**
+ * GridView::GridView(grid, x0, y0, x1, y1)
+ *
+ * Construct a view of the window [x0, x1) by [y0, y1) of a grid, matching the arguments of Grid::crop.
+ *
+ * @example
+ *
+ *      // Look at the centre 2x2 of a 4x4 grid
+ *      Grid grid(4, 4);
+ *      GridView centre(grid, 1, 1, 3, 3);
+ *
+ * @throws
+ *      std::out_of_range if the window is not within the grid, or std::logic_error if it has a negative size.
+ */
+GridView::GridView(const Grid& grid, const std::size_t x0, const std::size_t y0,
+                   const std::size_t x1, const std::size_t y1) : GridView(GridView(grid).crop(x0, y0, x1, y1)){}
+
+/**
+ * GridView::get_width()
+ *
+ * @return
+ *      The width of the view, after any rotation.
+ */
+std::size_t GridView::get_width() const {
+    return width;
+}
+
+/**
+ * GridView::get_height()
+ *
+ * @return
+ *      The height of the view, after any rotation.
+ */
+std::size_t GridView::get_height() const {
+    return height;
+}
+
+/**
+ * GridView::get_total_cells()
+ *
+ * @return
+ *      The number of cells the view can see.
+ */
+std::size_t GridView::get_total_cells() const {
+    return width * height;
+}
+
+/**
+ * GridView::get_alive_cells()
+ *
+ * Counts how many cells the view can see that are alive.
+ *
+ * @return
+ *      The number of alive cells.
+ */
+std::size_t GridView::get_alive_cells() const {
+    std::size_t alive_count = 0;
+    for (std::size_t i = 0; i < height; i++){
+        const Cell *cells = row(i);
+        if (cells != nullptr){
+            alive_count += std::count(cells, cells + width, Cell::ALIVE);
+        } else {
+            for (std::size_t j = 0; j < width; j++){
+                alive_count += (operator()(j, i) == Cell::ALIVE);
+            }
+        }
+    }
+    return alive_count;
+}
+
+/**
+ * GridView::get_dead_cells()
+ *
+ * Counts how many cells the view can see that are dead.
+ *
+ * @return
+ *      The number of dead cells.
+ */
+std::size_t GridView::get_dead_cells() const {
+    return get_total_cells() - get_alive_cells();
+}
+
+/**
+ * GridView::get(x, y)
+ *
+ * Returns the value of the cell at the desired coordinate of the view.
+ *
+ * @param x
+ *      The x coordinate of the cell within the view.
+ *
+ * @param y
+ *      The y coordinate of the cell within the view.
+ *
+ * @return
+ *      The value of the desired cell.
+ *
+ * @throws
+ *      std::out_of_range if x,y is not a valid coordinate within the view.
+ */
+Cell GridView::get(const std::size_t x, const std::size_t y) const {
+    return operator()(x, y);
+}
+
+/**
+ * GridView::operator()(x, y)
+ *
+ * Gets a read-only reference to the cell of the underlying grid seen at the desired coordinate of the view.
+ *
+ * @param x
+ *      The x coordinate of the cell within the view.
+ *
+ * @param y
+ *      The y coordinate of the cell within the view.
+ *
+ * @return
+ *      A read-only reference to the desired cell.
+ *
+ * @throws
+ *      std::out_of_range if x,y is not a valid coordinate within the view.
+ */
+const Cell& GridView::operator()(const std::size_t x, const std::size_t y) const {
+    if (x >= width || y >= height){
+        throw std::out_of_range("Incorrect values provided");
+    }
+
+    //Map the view coordinate back onto the grid
+    return grid->operator()(static_cast<std::size_t>(origin_x + xx * static_cast<long long>(x) + xy * static_cast<long long>(y)),
+                            static_cast<std::size_t>(origin_y + yx * static_cast<long long>(x) + yy * static_cast<long long>(y)));
+}
+
+/**
+ * GridView::row(y)
+ *
+ * Gets a pointer to the cells of row y when the view walks along a row of the underlying grid from left
+ * to right, which is the case for any view that has not been rotated or reflected. Callers can then copy
+ * or scan the row in bulk, and fall back to per cell access when nullptr is returned.
+ *
+ * @param y
+ *      The y coordinate of the row within the view.
+ *
+ * @return
+ *      A pointer to width contiguous cells, or nullptr if the row is not contiguous or the view is empty.
+ *
+ * @throws
+ *      std::out_of_range if y is not a valid row within the view.
+ */
+const Cell* GridView::row(const std::size_t y) const {
+    if (y >= height){
+        throw std::out_of_range("Incorrect values provided");
+    }
+    if (xx != 1 || yx != 0 || width == 0){
+        return nullptr;
+    }
+    return &operator()(0, y);
+}
+
+/**
+ * GridView::crop(x0, y0, x1, y1)
+ *
+ * Make a view of the window [x0, x1) by [y0, y1) of this view.
+ *
+ * @example
+ *
+ *      // The top half of a rotated grid
+ *      GridView top = GridView(grid).rotate(1).crop(0, 0, grid.get_height(), grid.get_width() / 2);
+ *
+ * @return
+ *      A new view of the window.
+ *
+ * @throws
+ *      std::out_of_range if the window is not within the view, or std::logic_error if it has a negative size.
+ */
+GridView GridView::crop(const std::size_t x0, const std::size_t y0,
+                        const std::size_t x1, const std::size_t y1) const {
+    if ((x0 > x1) || (y0 > y1)){
+        throw std::logic_error("Cropped view window size is invalid");
+    }
+    if ((x1 > width) || (y1 > height)){
+        throw std::out_of_range("One of more values not in range");
+    }
+
+    //Shift the origin to the new top left corner, the direction of each axis stays the same
+    GridView cropped = *this;
+    cropped.origin_x = origin_x + xx * static_cast<long long>(x0) + xy * static_cast<long long>(y0);
+    cropped.origin_y = origin_y + yx * static_cast<long long>(x0) + yy * static_cast<long long>(y0);
+    cropped.width = x1 - x0;
+    cropped.height = y1 - y0;
+    return cropped;
+}
+
+/**
+ * GridView::rotate(rotation)
+ *
+ * Make a view of this view rotated by a multiple of 90 degrees, following the same convention as Grid::rotate.
+ * The rotation can be any integer, positive, negative, or 0.
+ *
+ * @example
+ *
+ *      // Look at a glider flying the other way without copying it
+ *      GridView glider180 = GridView(glider).rotate(2);
+ *
+ * @param rotation
+ *      An positive or negative integer to rotate by in 90 intervals.
+ *
+ * @return
+ *      A new rotated view.
+ */
+GridView GridView::rotate(const int rotation) const {
+    GridView rotated = *this;
+
+    //Apply single quarter turns, so the view seen at (x, y) is the one previously seen at (y, height - 1 - x)
+    const int quarter_turns = ((rotation % 4) + 4) % 4;
+    for (int i = 0; i < quarter_turns; i++){
+        GridView turned = rotated;
+        turned.origin_x = rotated.origin_x + rotated.xy * (static_cast<long long>(rotated.height) - 1);
+        turned.origin_y = rotated.origin_y + rotated.yy * (static_cast<long long>(rotated.height) - 1);
+        turned.xx = -rotated.xy;
+        turned.yx = -rotated.yy;
+        turned.xy = rotated.xx;
+        turned.yy = rotated.yx;
+        turned.width = rotated.height;
+        turned.height = rotated.width;
+        rotated = turned;
+    }
+    return rotated;
+}
+
+/**
+ * GridView::reflect()
+ *
+ * Make a view of this view mirrored left to right. Together with GridView::rotate this gives all 8
+ * symmetries of a grid.
+ *
+ * @return
+ *      A new reflected view.
+ */
+GridView GridView::reflect() const {
+    //The view seen at (x, y) is the one previously seen at (width - 1 - x, y)
+    GridView reflected = *this;
+    reflected.origin_x = origin_x + xx * (static_cast<long long>(width) - 1);
+    reflected.origin_y = origin_y + yx * (static_cast<long long>(width) - 1);
+    reflected.xx = -xx;
+    reflected.yx = -yx;
+    return reflected;
+}
+
+/**
+ * GridView::to_grid(resource = nullptr)
+ *
+ * Copy the cells seen by the view into a new grid the size of the view.
+ *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate the new grid from, defaults to the default resource.
+ *
+ * @return
+ *      A new grid holding a copy of what the view sees.
+ */
+Grid GridView::to_grid(std::pmr::memory_resource *resource) const {
+    Grid copy(width, height, resource);
+    for (std::size_t i = 0; i < height; i++){
+        const Cell *cells = row(i);
+        for (std::size_t j = 0; j < width; j++){
+            copy(j, i) = (cells != nullptr) ? cells[j] : operator()(j, i);
+        }
+    }
+    return copy;
+}
@@ -0,0 +1,59 @@
+/**
+ * Declares a class representing a read-only window onto a Grid that never copies any cells.
+ * Rich documentation for the api and behaviour the GridView class can be found in grid_view.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include "grid.h"
+
+/**
+ * Declare the structure of the GridView class for looking at part of a grid, or a rotated or reflected grid.
+ *
+ * A view maps its own coordinates onto the coordinates of the grid it looks at through an index transform:
+ *      grid_x = origin_x + xx * x + xy * y
+ *      grid_y = origin_y + yx * x + yy * y
+ * where the coefficients are all -1, 0 or 1. Cropping, rotating and reflecting a view just updates the transform.
+ *
+ * A view is only valid while the grid it looks at is alive and has not been resized.
+ */
+class GridView {
+private:
+    const Grid *grid;
+
+    //The size of the view in its own coordinates
+    std::size_t width;
+    std::size_t height;
+
+    //The index transform from view coordinates to grid coordinates
+    long long origin_x;
+    long long origin_y;
+    int xx, xy, yx, yy;
+
+public:
+    //Views are cheap to make, so a whole grid converts to a view implicitly wherever one is expected
+    GridView(const Grid& grid);
+    GridView(const Grid& grid, std::size_t x0, std::size_t y0, std::size_t x1, std::size_t y1);
+
+    //Getter methods that mirror those of the Grid class
+    std::size_t get_width() const;
+    std::size_t get_height() const;
+    std::size_t get_total_cells() const;
+    std::size_t get_alive_cells() const;
+    std::size_t get_dead_cells() const;
+    Cell get(std::size_t x, std::size_t y) const;
+    const Cell& operator()(std::size_t x, std::size_t y) const;
+
+    //Returns a pointer to row y if the view reads it left to right from contiguous cells, otherwise nullptr
+    const Cell* row(std::size_t y) const;
+
+    //Make new views of this view, none of these copy any cells
+    GridView crop(std::size_t x0, std::size_t y0, std::size_t x1, std::size_t y1) const;
+    GridView rotate(int rotation) const;
+    GridView reflect() const;
+
+    //Copies the cells the view can see into a new grid, allocated from resource if one is given
+    Grid to_grid(std::pmr::memory_resource *resource = nullptr) const;
+};
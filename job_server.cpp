@@ -0,0 +1,596 @@
+/**
+ * Implements a long running server that takes simulation jobs over a Unix domain socket.
+ *      - Starting a process, parsing a pattern and allocating grids can cost far more than running a small
+ *        simulation. The server does that work once: worker threads are started with the server, parsed
+ *        pattern files are kept until they change on disk, and each worker keeps its grids in thread_local
+ *        buffers that are only reallocated when a job needs a different size.
+ *      - The protocol is line based. Each request is one line of space separated key=value pairs and each
+ *        response is one line, sent as soon as its job finishes, so responses may arrive out of order and
+ *        carry the id of the request they answer.
+ *
+ *        Request keys:
+ *          id          Optional. Echoed back in the response. Defaults to -.
+ *          source      Required. file:PATH for a .gol ascii or .bgol binary file, or zoo:NAME for one of
+ *                      glider, r_pentomino or light_weight_spaceship, optionally zoo:NAME@WxH to place the
+ *                      lifeform in the middle of a larger world.
+ *          steps       Optional. The number of generations to simulate. Defaults to 0.
+ *          toroidal    Optional. 1 or true to simulate on a torus. Defaults to 0.
+ *          rule        Optional. Only B3/S23, the rule World implements, is accepted. Defaults to B3/S23.
+ *          cells       Optional. 1 or true to include the final cells in the response. Defaults to 0.
+ *
+ *        Responses:
+ *          id=7 status=ok steps=100 alive=5 dead=59 width=8 height=8 micros=12 [cells=ROW/ROW/...]
+ *          id=7 status=error message=...
+ *
+ *        Where each ROW uses # for alive cells and . for dead cells.
+ *
+ *      - Each client gets a thread that reads its requests. Requests that arrive together are grouped into
+ *        a few pool tasks rather than one task each, so tiny jobs do not drown in queueing overhead. When a
+ *        client hangs up its thread waits for that client's jobs to finish before closing the connection, and
+ *        the threads of clients that have gone are joined as the next client is accepted.
+ *      - A request line longer than max_line_bytes is answered with an error and skipped up to its newline,
+ *        so a client that never sends one cannot make the server buffer without limit.
+ *      - A zoo:NAME@WxH world of more than max_cells cells is answered with an error rather than allocated.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "job_server.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "kernel.h"
+#include "zoo.h"
+
+namespace {
+    //How many jobs from one read are grouped into a single pool task
+    constexpr std::size_t jobs_per_task = 16;
+
+    //The longest request line accepted, far longer than any valid request needs
+    constexpr std::size_t max_line_bytes = 64 * 1024;
+
+    //The most cells a zoo:NAME@WxH world may have, so one request cannot make the server allocate without limit
+    constexpr std::size_t max_cells = std::size_t(1) << 26;
+
+    //State shared between a client's reading thread and the pool tasks running its jobs
+    struct Connection {
+        int socket;
+        std::mutex write_mutex;
+
+        std::mutex pending_mutex;
+        std::condition_variable finished;
+        std::size_t pending = 0;
+
+        explicit Connection(const int socket) : socket(socket) {}
+
+        //Sends a whole line, giving up quietly if the client has gone away
+        void send_line(const std::string& line) {
+            std::lock_guard<std::mutex> lock(write_mutex);
+            const std::string message = line + "\n";
+            std::size_t sent = 0;
+            while (sent < message.size()) {
+                const ssize_t n = ::send(socket, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+                if (n <= 0) {
+                    return;
+                }
+                sent += static_cast<std::size_t>(n);
+            }
+        }
+    };
+
+    bool parse_flag(const std::string& value, bool &flag) {
+        if (value == "1" || value == "true") {
+            flag = true;
+            return true;
+        }
+        if (value == "0" || value == "false") {
+            flag = false;
+            return true;
+        }
+        return false;
+    }
+
+    bool ends_with(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    std::string error_line(const std::string& id, const std::string& message) {
+        return "id=" + id + " status=error message=" + message;
+    }
+}
+
+/**
+ * JobServer::JobServer(path, threads = 0)
+ *
+ * Construct a server listening on a Unix domain socket. A socket file already at the path is removed first if
+ * nothing is listening on it, as happens when a server did not shut down cleanly. A socket another server is still
+ * listening on, and any other kind of file, is left alone and the server fails to start.
+ *
+ * @example
+ *
+ *      // Serve jobs until something calls stop
+ *      JobServer server("/tmp/gol.sock");
+ *      server.serve();
+ *
+ *      // Then, from a shell
+ *      echo "id=1 source=zoo:glider@16x16 steps=40 cells=1" | nc -U /tmp/gol.sock
+ *
+ * @param path
+ *      The path of the socket file.
+ *
+ * @param threads
+ *      Optional parameter. The number of threads running jobs, 0 for one per hardware thread. Defaults to 0.
+ *
+ * @throws
+ *      std::runtime_error if the socket cannot be created, bound or listened on, or another server is listening
+ *      on the path.
+ */
+JobServer::JobServer(const std::string& path, const unsigned int threads)
+    : path(path), pool(threads), listener(-1), stopping(false) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is empty or too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw std::runtime_error("Cannot create a socket for " + path);
+    }
+
+    //Only a socket nobody answers on is stale, taking over a live one would silently steal its server's clients
+    struct stat info{};
+    if (::stat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        if (::connect(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) {
+            ::close(listener);
+            throw std::runtime_error("Another server is already listening on " + path);
+        }
+        if (errno == ECONNREFUSED) {
+            ::unlink(path.c_str());
+        }
+        //A failed connect leaves the socket unusable, start again with a fresh one
+        ::close(listener);
+        listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) {
+            throw std::runtime_error("Cannot create a socket for " + path);
+        }
+    }
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, SOMAXCONN) != 0) {
+        ::close(listener);
+        throw std::runtime_error("Cannot listen on " + path + ": " + std::strerror(errno));
+    }
+}
+
+/**
+ * JobServer::~JobServer()
+ *
+ * Stop accepting clients, wait for the clients already connected to hang up, and remove the socket file.
+ */
+JobServer::~JobServer() {
+    stop();
+    std::map<std::size_t, std::thread> finishing;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        finishing.swap(connections);
+        finished_connections.clear();
+    }
+    for (auto& connection : finishing) {
+        connection.second.join();
+    }
+    ::close(listener);
+    ::unlink(path.c_str());
+}
+
+/**
+ * JobServer::serve()
+ *
+ * Accept clients until stop is called, giving each one a thread that reads its requests.
+ */
+void JobServer::serve() {
+    while (!stopping) {
+        const int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (stopping) {
+                break;
+            }
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            std::cerr << "Cannot accept on " << path << ": " << std::strerror(errno) << std::endl;
+            break;
+        }
+        reap();
+
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        const std::size_t id = next_connection++;
+        connections.emplace(id, std::thread([this, client, id]() {
+            handle(client);
+            std::lock_guard<std::mutex> finished_lock(connections_mutex);
+            finished_connections.push_back(id);
+        }));
+    }
+}
+
+/**
+ * JobServer::reap()
+ *
+ * Private helper that joins the threads of clients that have hung up, so a server that runs for a long time
+ * only holds threads for the clients still connected.
+ */
+void JobServer::reap() {
+    std::vector<std::thread> finishing;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        for (const std::size_t id : finished_connections) {
+            auto connection = connections.find(id);
+            finishing.push_back(std::move(connection->second));
+            connections.erase(connection);
+        }
+        finished_connections.clear();
+    }
+    //Each of these has already handled its client, at most it is still returning
+    for (auto& connection : finishing) {
+        connection.join();
+    }
+}
+
+/**
+ * JobServer::stop()
+ *
+ * Make serve return. Safe to call from another thread, clients already connected are still served.
+ */
+void JobServer::stop() {
+    if (!stopping.exchange(true)) {
+        //Wakes up a thread blocked in accept
+        ::shutdown(listener, SHUT_RDWR);
+    }
+}
+
+/**
+ * JobServer::handle(client)
+ *
+ * Private body of a client's thread. Splits what it reads into lines, answers bad requests straight away and
+ * hands the rest to the pool in groups.
+ *
+ * @param client
+ *      The connected socket, closed before returning.
+ */
+void JobServer::handle(const int client) {
+    auto connection = std::make_shared<Connection>(client);
+
+    auto submit = [this, &connection](std::vector<Job> &jobs) {
+        if (jobs.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(connection->pending_mutex);
+            connection->pending++;
+        }
+        pool.submit([this, connection, jobs = std::move(jobs)]() {
+            for (const Job& job : jobs) {
+                connection->send_line(run(job));
+            }
+            std::lock_guard<std::mutex> lock(connection->pending_mutex);
+            if (--connection->pending == 0) {
+                connection->finished.notify_all();
+            }
+        });
+        jobs.clear();
+    };
+
+    std::string buffer;
+    char chunk[4096];
+    std::vector<Job> jobs;
+    bool discarding = false;
+    while (true) {
+        const ssize_t n = ::recv(client, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        buffer.append(chunk, static_cast<std::size_t>(n));
+
+        std::size_t start = 0, end;
+        while ((end = buffer.find('\n', start)) != std::string::npos) {
+            std::string line = buffer.substr(start, end - start);
+            start = end + 1;
+            if (discarding) {
+                //The rest of a line that was too long
+                discarding = false;
+                continue;
+            }
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.find_first_not_of(" \t") == std::string::npos) {
+                continue;
+            }
+
+            Job job;
+            std::string error;
+            if (!parse(line, job, error)) {
+                connection->send_line(error_line(job.id, error));
+                continue;
+            }
+            jobs.push_back(std::move(job));
+            if (jobs.size() == jobs_per_task) {
+                submit(jobs);
+            }
+        }
+        buffer.erase(0, start);
+        if (buffer.size() > max_line_bytes) {
+            if (!discarding) {
+                connection->send_line(error_line("-", "request is longer than " + std::to_string(max_line_bytes) +
+                                                      " bytes"));
+            }
+            discarding = true;
+            buffer.clear();
+        }
+
+        //Whatever arrived in this read is ready to go, waiting for more would only delay it
+        submit(jobs);
+    }
+
+    //The client may have half closed its end and still be waiting on responses
+    std::unique_lock<std::mutex> lock(connection->pending_mutex);
+    connection->finished.wait(lock, [&connection] { return connection->pending == 0; });
+    ::close(client);
+}
+
+/**
+ * JobServer::parse(line, job, error)
+ *
+ * Parse one request line.
+ *
+ * @param line
+ *      The request, space separated key=value pairs.
+ *
+ * @param job
+ *      Filled in with the request. The id is set as early as possible so errors can be matched up.
+ *
+ * @param error
+ *      Set to a description of the problem if the request is not valid.
+ *
+ * @return
+ *      True if the request is a valid job.
+ */
+bool JobServer::parse(const std::string& line, Job &job, std::string &error) {
+    job = Job{"-", "", 0, false, false};
+
+    //Find the id first so any error found below can be reported against it
+    std::vector<std::pair<std::string, std::string>> pairs;
+    std::istringstream tokens(line);
+    std::string token;
+    while (tokens >> token) {
+        const std::size_t equals = token.find('=');
+        if (equals == std::string::npos) {
+            error = "expected key=value but got " + token;
+            return false;
+        }
+        pairs.emplace_back(token.substr(0, equals), token.substr(equals + 1));
+        if (pairs.back().first == "id") {
+            job.id = pairs.back().second;
+        }
+    }
+
+    for (const auto& [key, value] : pairs) {
+        if (key == "id") {
+            continue;
+        } else if (key == "source") {
+            job.source = value;
+        } else if (key == "steps") {
+            if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+                error = "steps should be a non-negative integer";
+                return false;
+            }
+            try {
+                job.steps = std::stoull(value);
+            } catch (const std::out_of_range&) {
+                error = "steps is too large";
+                return false;
+            }
+        } else if (key == "toroidal") {
+            if (!parse_flag(value, job.toroidal)) {
+                error = "toroidal should be 0 or 1";
+                return false;
+            }
+        } else if (key == "cells") {
+            if (!parse_flag(value, job.want_cells)) {
+                error = "cells should be 0 or 1";
+                return false;
+            }
+        } else if (key == "rule") {
+            std::string rule = value;
+            std::transform(rule.begin(), rule.end(), rule.begin(), [](unsigned char c) { return std::toupper(c); });
+            if (rule != "B3/S23" && rule != "23/3") {
+                error = "only rule B3/S23 is supported";
+                return false;
+            }
+        } else {
+            error = "unknown key " + key;
+            return false;
+        }
+    }
+
+    if (job.source.empty()) {
+        error = "missing source";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * JobServer::load(source)
+ *
+ * Private helper that finds the starting grid for a source. Files are parsed once and the result shared until
+ * the file's modification time changes.
+ *
+ * @param source
+ *      file:PATH, zoo:NAME or zoo:NAME@WxH.
+ *
+ * @return
+ *      The starting grid, shared with other jobs so it must not be modified.
+ *
+ * @throws
+ *      std::runtime_error if the source is not recognised, the file cannot be read or a zoo world is larger
+ *      than max_cells.
+ */
+std::shared_ptr<const Grid> JobServer::load(const std::string& source) {
+    if (source.compare(0, 5, "file:") == 0) {
+        const std::string file = source.substr(5);
+        struct stat info{};
+        if (::stat(file.c_str(), &info) != 0) {
+            throw std::runtime_error("cannot find " + file);
+        }
+        const long long modified = static_cast<long long>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+
+        {
+            std::lock_guard<std::mutex> lock(patterns_mutex);
+            auto cached = patterns.find(file);
+            if (cached != patterns.end() && cached->second.modified == modified) {
+                return cached->second.grid;
+            }
+        }
+
+        //Parse without the lock held, two jobs racing on a new file just both parse it
+        auto grid = std::make_shared<const Grid>(ends_with(file, ".bgol") ? Zoo::load_binary(file)
+                                                                          : Zoo::load_ascii(file));
+        std::lock_guard<std::mutex> lock(patterns_mutex);
+        patterns[file] = Pattern{grid, modified};
+        return grid;
+    }
+
+    if (source.compare(0, 4, "zoo:") == 0) {
+        std::string name = source.substr(4);
+        std::size_t width = 0, height = 0;
+        const std::size_t at = name.find('@');
+        if (at != std::string::npos) {
+            char x = 0, extra = 0;
+            std::istringstream size(name.substr(at + 1));
+            if (!(size >> width >> x >> height) || (x != 'x' && x != 'X') || (size >> extra)) {
+                throw std::runtime_error("size should be given as WxH");
+            }
+            name.erase(at);
+        }
+
+        Grid lifeform;
+        if (name == "glider") {
+            lifeform = Zoo::glider();
+        } else if (name == "r_pentomino") {
+            lifeform = Zoo::r_pentomino();
+        } else if (name == "light_weight_spaceship") {
+            lifeform = Zoo::light_weight_spaceship();
+        } else {
+            throw std::runtime_error("unknown lifeform " + name);
+        }
+
+        if (at == std::string::npos) {
+            return std::make_shared<const Grid>(std::move(lifeform));
+        }
+        if (width < lifeform.get_width() || height < lifeform.get_height()) {
+            throw std::runtime_error("world is too small for " + name);
+        }
+        if (width > max_cells / height) {
+            throw std::runtime_error("world is larger than " + std::to_string(max_cells) + " cells");
+        }
+        Grid world(width, height);
+        world.merge(lifeform.view(), (width - lifeform.get_width()) / 2, (height - lifeform.get_height()) / 2);
+        return std::make_shared<const Grid>(std::move(world));
+    }
+
+    throw std::runtime_error("source should start with file: or zoo:");
+}
+
+/**
+ * JobServer::run(job)
+ *
+ * Run a job on the calling thread. The grids it steps are thread_local, so a worker running many jobs of the
+ * same size never allocates.
+ *
+ * @param job
+ *      The job to run.
+ *
+ * @return
+ *      The response line for the job, without a trailing newline. Failures are reported in the line rather than
+ *      thrown.
+ */
+std::string JobServer::run(const Job& job) {
+    thread_local Grid current;
+    thread_local Grid next;
+
+    try {
+        const auto start = std::chrono::steady_clock::now();
+        const std::shared_ptr<const Grid> initial = load(job.source);
+        const std::size_t width = initial->get_width();
+        const std::size_t height = initial->get_height();
+
+        if (current.get_width() != width || current.get_height() != height) {
+            current.resize(width, height, false);
+            next.resize(width, height, false);
+        }
+        for (std::size_t y = 0; y < height; y++) {
+            std::memcpy(current.row(y, Grid::unchecked), initial->row(y, Grid::unchecked), width * sizeof(Cell));
+        }
+
+        //The same update as World::step, without a World to allocate
+        for (std::size_t step = 0; step < job.steps && height > 0; step++) {
+            for (std::size_t y = 0; y < height; y++) {
+                const Cell *above = nullptr;
+                const Cell *below = nullptr;
+                if (y > 0 || job.toroidal) {
+                    above = current.row((y > 0) ? y - 1 : height - 1, Grid::unchecked);
+                }
+                if (y + 1 < height || job.toroidal) {
+                    below = current.row((y + 1 < height) ? y + 1 : 0, Grid::unchecked);
+                }
+                Kernel::step_row(above, current.row(y, Grid::unchecked), below, next.row(y, Grid::unchecked),
+                                 width, job.toroidal);
+            }
+            std::swap(current, next);
+        }
+
+        const std::size_t alive = current.get_alive_cells();
+        const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+
+        std::string line = "id=" + job.id + " status=ok steps=" + std::to_string(job.steps) +
+                           " alive=" + std::to_string(alive) +
+                           " dead=" + std::to_string(current.get_total_cells() - alive) +
+                           " width=" + std::to_string(width) + " height=" + std::to_string(height) +
+                           " micros=" + std::to_string(micros);
+        if (job.want_cells) {
+            line.reserve(line.size() + 7 + (width + 1) * height);
+            line += " cells=";
+            for (std::size_t y = 0; y < height; y++) {
+                if (y > 0) {
+                    line += '/';
+                }
+                const Cell *row = current.row(y, Grid::unchecked);
+                for (std::size_t x = 0; x < width; x++) {
+                    line += (row[x] == Cell::ALIVE) ? '#' : '.';
+                }
+            }
+        }
+        return line;
+    }
+    catch (const std::exception &ex) {
+        //Keep the response on one line whatever the message says
+        std::string message = ex.what();
+        std::replace(message.begin(), message.end(), '\n', ' ');
+        return error_line(job.id, message);
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * Declares a long running server that takes simulation jobs over a Unix domain socket and runs them on a pool.
+ * Rich documentation for the api, behaviour and protocol of the JobServer class can be found in job_server.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "grid.h"
+#include "thread_pool.h"
+
+/**
+ * Declare the structure of the JobServer class, which keeps its threads, buffers and parsed patterns warm so
+ * thousands of small simulations cost little more than the stepping itself.
+ */
+class JobServer {
+public:
+    //One job, parsed from a request line
+    struct Job {
+        std::string id;
+        std::string source;
+        std::size_t steps;
+        bool toroidal;
+        bool want_cells;
+    };
+
+private:
+    //A parsed pattern file, kept until the file changes
+    struct Pattern {
+        std::shared_ptr<const Grid> grid;
+        long long modified;
+    };
+
+    std::string path;
+    ThreadPool pool;
+    int listener;
+    std::atomic<bool> stopping;
+
+    std::mutex patterns_mutex;
+    std::map<std::string, Pattern> patterns;
+
+    //The thread of each connected client, and the ones whose client has gone and can be joined
+    std::mutex connections_mutex;
+    std::map<std::size_t, std::thread> connections;
+    std::vector<std::size_t> finished_connections;
+    std::size_t next_connection = 0;
+
+    //Reads requests from one client until it hangs up, streaming results back as jobs finish
+    void handle(int client);
+
+    //Joins the threads of clients that have hung up
+    void reap();
+
+    //Finds the starting grid for a source, reading files at most once while they are unchanged
+    std::shared_ptr<const Grid> load(const std::string& source);
+
+public:
+    //Binds the socket at path, replacing any stale socket left behind, 0 threads means one per hardware thread
+    explicit JobServer(const std::string& path, unsigned int threads = 0);
+    ~JobServer();
+
+    JobServer(const JobServer&) = delete;
+    JobServer& operator=(const JobServer&) = delete;
+
+    //Accepts clients until stop is called
+    void serve();
+    void stop();
+
+    //Parses a request line, returning false and setting error if it is not a valid job
+    static bool parse(const std::string& line, Job &job, std::string &error);
+
+    //Runs a job on the calling thread and returns the response line, without the newline
+    std::string run(const Job& job);
+};
@@ -0,0 +1,169 @@
+/**
+ * Implements a Kernel namespace with the row based update rules shared by the different ways of stepping a world.
+ *      - Kernels work on raw rows of cells rather than whole grids, so they can be fed from any storage,
+ *        including rows streamed in from a file.
+ *      - A missing row (nullptr) above or below is treated as entirely Cell::DEAD.
+ *      - The results match World::step exactly, including how a toroidal topology wraps around.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "kernel.h"
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    //The low bit of a cell is set exactly when it is alive, so masking it out of each byte counts alive cells
+    static_assert((static_cast<unsigned char>(Cell::ALIVE) & 1) == 1 &&
+                  (static_cast<unsigned char>(Cell::DEAD) & 1) == 0,
+                  "step_interior relies on the low bit of a cell being whether it is alive");
+    static_assert((static_cast<unsigned char>(Cell::ALIVE) & ~3) == static_cast<unsigned char>(Cell::DEAD),
+                  "step_interior builds alive cells by setting the low two bits of a dead cell");
+
+    constexpr std::uint64_t low_bits = 0x0101010101010101ull;
+
+    //Eight cells starting at cells[x], reduced to a 1 in the low bit of each byte that is alive
+    std::uint64_t load(const Cell *cells, const std::size_t x) {
+        std::uint64_t word;
+        std::memcpy(&word, cells + x, sizeof(word));
+        return word & low_bits;
+    }
+
+    //Steps cells [1, width - 1) of a row, which have both horizontal neighbours. Eight cells at a time are packed
+    //into a 64 bit word with one cell per byte, and neighbour counts of at most 8 are added up a byte at a time
+    //without ever carrying into the next cell. Rows known to be missing are left out at compile time
+    template <bool HasAbove, bool HasBelow>
+    void step_interior(const Cell *above, const Cell *row, const Cell *below, Cell *out, const std::size_t width) {
+        const std::uint64_t dead = low_bits * static_cast<unsigned char>(Cell::DEAD);
+        std::size_t x = 1;
+        for (; x + 9 <= width; x += 8){
+            const std::uint64_t self = load(row, x);
+            std::uint64_t neighbours = load(row, x - 1) + load(row, x + 1);
+            if (HasAbove){
+                neighbours += load(above, x - 1) + load(above, x) + load(above, x + 1);
+            }
+            if (HasBelow){
+                neighbours += load(below, x - 1) + load(below, x) + load(below, x + 1);
+            }
+
+            //Born with exactly three neighbours, survives with two or three, which is exactly when
+            //neighbours | self is 3. Any other value leaves one of the low four bits of the xor with 3 set
+            const std::uint64_t other = (neighbours | self) ^ (low_bits * 3);
+            const std::uint64_t wrong = (other | (other >> 1) | (other >> 2) | (other >> 3)) & low_bits;
+            const std::uint64_t cells = dead | ((wrong ^ low_bits) * 3);
+            std::memcpy(out + x, &cells, sizeof(cells));
+        }
+
+        //The last few cells one at a time
+        for (; x + 1 < width; x++){
+            unsigned int neighbours = (row[x - 1] == Cell::ALIVE) + (row[x + 1] == Cell::ALIVE);
+            if (HasAbove){
+                neighbours += (above[x - 1] == Cell::ALIVE) + (above[x] == Cell::ALIVE) + (above[x + 1] == Cell::ALIVE);
+            }
+            if (HasBelow){
+                neighbours += (below[x - 1] == Cell::ALIVE) + (below[x] == Cell::ALIVE) + (below[x + 1] == Cell::ALIVE);
+            }
+            out[x] = Kernel::next_state(row[x], neighbours);
+        }
+    }
+}
+
+/**
+ * Kernel::next_state(cell, neighbours)
+ *
+ * Apply the rules of Conway's Game of Life to a single cell.
+ *
+ * @example
+ *
+ *      // A dead cell with three neighbours is born
+ *      Cell cell = Kernel::next_state(Cell::DEAD, 3);
+ *
+ * @param cell
+ *      The current value of the cell.
+ *
+ * @param neighbours
+ *      The number of alive cells in the 3x3 neighbourhood around the cell, not counting the cell itself.
+ *
+ * @return
+ *      The value of the cell in the next generation.
+ */
+Cell Kernel::next_state(const Cell cell, const unsigned int neighbours) {
+    //Born with exactly three neighbours, survives with two or three
+    if ((neighbours == 3) || ((neighbours == 2) && (cell == Cell::ALIVE))){
+        return Cell::ALIVE;
+    }
+    return Cell::DEAD;
+}
+
+/**
+ * Kernel::step_row(above, row, below, out, width, toroidal)
+ *
+ * Compute the next generation of a single row of cells.
+ *
+ * Every cell but the two at the ends has both horizontal neighbours, so the interior of the row is stepped
+ * eight cells at a time in a 64 bit word with no branches per cell. The two end cells are then done on their
+ * own, wrapping round if toroidal. Wrapping between the top and bottom
+ * edges is the callers job, they simply pass the wrapped rows in as above and below.
+ *
+ * @example
+ *
+ *      // Step the middle row of a 3 row grid
+ *      Kernel::step_row(&grid(0, 0), &grid(0, 1), &grid(0, 2), out.data(), grid.get_width(), false);
+ *
+ * @param above
+ *      The row above the one being updated, or nullptr if there is no such row.
+ *
+ * @param row
+ *      The row being updated.
+ *
+ * @param below
+ *      The row below the one being updated, or nullptr if there is no such row.
+ *
+ * @param out
+ *      Where to write the next generation of the row, must hold width cells and must not alias the inputs.
+ *
+ * @param width
+ *      The number of cells in each row.
+ *
+ * @param toroidal
+ *      If true then the left edge of the row wraps to the right edge.
+ */
+void Kernel::step_row(const Cell *above, const Cell *row, const Cell *below, Cell *out,
+                      const std::size_t width, const bool toroidal) {
+    if (width == 0){
+        return;
+    }
+
+    //The interior has no edges to wrap, so it gets a branch free loop of its own
+    if (width > 2){
+        if (above != nullptr && below != nullptr){
+            step_interior<true, true>(above, row, below, out, width);
+        } else if (above != nullptr){
+            step_interior<true, false>(above, row, below, out, width);
+        } else if (below != nullptr){
+            step_interior<false, true>(above, row, below, out, width);
+        } else {
+            step_interior<false, false>(above, row, below, out, width);
+        }
+    }
+
+    //The number of alive cells in the column of three cells centred on row[x]
+    auto column = [&](std::size_t x) -> unsigned int {
+        return (above != nullptr && above[x] == Cell::ALIVE) +
+               (row[x] == Cell::ALIVE) +
+               (below != nullptr && below[x] == Cell::ALIVE);
+    };
+
+    //The two end cells, wrapping round if toroidal
+    for (const std::size_t x : {std::size_t(0), width - 1}){
+        const unsigned int left = (x > 0) ? column(x - 1) : (toroidal ? column(width - 1) : 0);
+        const unsigned int right = (x + 1 < width) ? column(x + 1) : (toroidal ? column(0) : 0);
+        const unsigned int middle = column(x) - (row[x] == Cell::ALIVE);
+
+        //A one cell wide torus sees the cell itself as its left and right neighbours
+        out[x] = next_state(row[x], left + middle + right);
+        if (width == 1){
+            break;
+        }
+    }
+}
@@ -0,0 +1,21 @@
+/**
+ * Declares a Kernel namespace with the row based update rules shared by the different ways of stepping a world.
+ * Rich documentation for the api and behaviour the Kernel namespace can be found in kernel.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include "grid.h"
+
+/**
+ * Declare the interface of the Kernel namespace for applying Conway's rules to whole rows of cells at a time.
+ */
+namespace Kernel {
+    //Applies the rules to a single cell given how many alive neighbours it has
+    Cell next_state(Cell cell, unsigned int neighbours);
+
+    //Computes the next state of one row from the row itself and the rows directly above and below it
+    void step_row(const Cell *above, const Cell *row, const Cell *below, Cell *out, std::size_t width, bool toroidal);
+};
@@ -0,0 +1,289 @@
+/**
+ * Implements a PatternMatch namespace for finding every copy of a pattern in a world, in any orientation.
+ *      - Every orientation of every pattern is made up front, and orientations that come out identical, such
+ *        as the rotations of a block or two phases of a glider that are mirror images, are only searched once.
+ *      - World rows are packed into 64 bit words, with a copy inverted so dead cells can be matched the same
+ *        way as alive ones. For each distinct pattern row, a shift-and over the row's cells gives a word of
+ *        match bits for 64 starting columns at once: bit x is set if the pattern row matches the world row
+ *        starting at column x.
+ *      - A pattern matches at x, y if bit x is set for each of its rows against the world rows below y. The
+ *        match words of the last few world rows are kept in a ring, so each is only worked out once.
+ *      - The world is scanned in bands of rows in parallel with GridMemory::for_each_band. Each band works out
+ *        the few rows past its end that its last matches need.
+ *      - The world is treated as having a ring of dead cells around it, so an isolated copy may touch the edge.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "pattern_match.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include "grid_memory.h"
+
+namespace {
+    using Word = std::uint64_t;
+    constexpr std::size_t word_bits = 64;
+
+    //One orientation of one pattern, with each of its rows given as the index of a distinct row
+    struct Orientation {
+        std::size_t pattern;
+        int rotation;
+        bool mirrored;
+        std::size_t width;
+        std::size_t height;
+        std::vector<std::size_t> rows;
+    };
+
+    Grid mirror(const Grid& grid) {
+        Grid mirrored(grid.get_width(), grid.get_height());
+        for (std::size_t y = 0; y < grid.get_height(); y++) {
+            std::reverse_copy(grid.row(y, Grid::unchecked), grid.row(y, Grid::unchecked) + grid.get_width(),
+                              mirrored.row(y, Grid::unchecked));
+        }
+        return mirrored;
+    }
+
+    //A copy of the grid with a ring of dead cells around it
+    Grid with_border(const Grid& grid) {
+        Grid bordered(grid.get_width() + 2, grid.get_height() + 2);
+        for (std::size_t y = 0; y < grid.get_height(); y++) {
+            std::copy(grid.row(y, Grid::unchecked), grid.row(y, Grid::unchecked) + grid.get_width(),
+                      bordered.row(y + 1, Grid::unchecked) + 1);
+        }
+        return bordered;
+    }
+
+    std::string row_key(const Grid& grid, const std::size_t y) {
+        return std::string(reinterpret_cast<const char *>(grid.row(y, Grid::unchecked)), grid.get_width());
+    }
+
+    std::string grid_key(const Grid& grid) {
+        std::string key = std::to_string(grid.get_width()) + "x" + std::to_string(grid.get_height()) + ":";
+        for (std::size_t y = 0; y < grid.get_height(); y++) {
+            key += row_key(grid, y);
+        }
+        return key;
+    }
+}
+
+/**
+ * PatternMatch::find_pattern(world, pattern, isolated = false)
+ *
+ * Find every copy of a pattern in a world, in any of its 8 orientations. The whole rectangle of the pattern has
+ * to match, dead cells as well as alive ones.
+ *
+ * @example
+ *
+ *      // Find every glider heading in any direction in a world, in the phase Zoo::glider is stored in
+ *      for (const PatternMatch::Match& match : PatternMatch::find_pattern(world, Zoo::glider(), true)){
+ *          std::cout << match.x << "," << match.y << std::endl;
+ *      }
+ *
+ * @param world
+ *      The grid to search.
+ *
+ * @param pattern
+ *      The pattern to look for.
+ *
+ * @param isolated
+ *      Optional parameter. If true the cells directly around a copy, outside the pattern's rectangle, must be
+ *      dead too. Cells beyond the edge of the world count as dead. Defaults to false.
+ *
+ * @return
+ *      Every copy found, sorted by row then column. A position is reported once for each distinct
+ *      orientation that matches there.
+ *
+ * @throws
+ *      std::logic_error if the pattern is empty.
+ */
+std::vector<PatternMatch::Match> PatternMatch::find_pattern(const Grid& world, const Grid& pattern, const bool isolated) {
+    return find_patterns(world, std::vector<Grid>{pattern}, isolated);
+}
+
+/**
+ * PatternMatch::find_patterns(world, patterns, isolated = false)
+ *
+ * Find every copy of any of a list of patterns in a world, in any of their 8 orientations, in one pass.
+ *
+ * @example
+ *
+ *      // Find every glider in any of its phases, saved as glider_0.gol to glider_3.gol
+ *      std::vector<Grid> phases;
+ *      for (int i = 0; i < 4; i++){
+ *          phases.push_back(Zoo::load_ascii("glider_" + std::to_string(i) + ".gol"));
+ *      }
+ *      auto gliders = PatternMatch::find_patterns(world, phases, true);
+ *
+ * @param world
+ *      The grid to search.
+ *
+ * @param patterns
+ *      The patterns to look for.
+ *
+ * @param isolated
+ *      Optional parameter. If true the cells directly around a copy must be dead too. Defaults to false.
+ *
+ * @return
+ *      Every copy found, sorted by row then column. Orientations of different patterns that are identical are
+ *      reported once, against the first pattern that has them.
+ *
+ * @throws
+ *      std::logic_error if any pattern is empty.
+ */
+std::vector<PatternMatch::Match> PatternMatch::find_patterns(const Grid& world, const std::vector<Grid>& patterns,
+                                                             const bool isolated) {
+    const std::size_t width = world.get_width();
+    const std::size_t height = world.get_height();
+
+    //Make every distinct orientation, and number the distinct rows they are made from
+    std::vector<Orientation> orientations;
+    std::vector<std::string> rows;
+    std::map<std::string, std::size_t> row_ids;
+    std::set<std::string> seen;
+    for (std::size_t p = 0; p < patterns.size(); p++) {
+        if (patterns[p].get_width() == 0 || patterns[p].get_height() == 0) {
+            throw std::logic_error("Cannot search for an empty pattern");
+        }
+        const Grid mirrored = mirror(patterns[p]);
+        for (const bool flip : {false, true}) {
+            for (int rotation = 0; rotation < 4; rotation++) {
+                const Grid oriented = (flip ? mirrored : patterns[p]).rotate(rotation);
+                if (oriented.get_width() > width || oriented.get_height() > height ||
+                    !seen.insert(grid_key(oriented)).second) {
+                    continue;
+                }
+
+                const Grid searched = isolated ? with_border(oriented) : oriented;
+                Orientation orientation{p, rotation, flip, oriented.get_width(), oriented.get_height(), {}};
+                for (std::size_t y = 0; y < searched.get_height(); y++) {
+                    const auto id = row_ids.emplace(row_key(searched, y), rows.size());
+                    if (id.second) {
+                        rows.push_back(id.first->first);
+                    }
+                    orientation.rows.push_back(id.first->second);
+                }
+                orientations.push_back(std::move(orientation));
+            }
+        }
+    }
+    if (orientations.empty()) {
+        return {};
+    }
+
+    //The world is searched as if surrounded by a ring of dead cells, so padded row r is world row r - 1
+    const std::size_t padded_width = width + 2;
+    const std::size_t padded_height = height + 2;
+    std::size_t depth = 0, widest = 0;
+    for (const auto& orientation : orientations) {
+        depth = std::max(depth, orientation.rows.size());
+    }
+    for (const auto& row : rows) {
+        widest = std::max(widest, row.size());
+    }
+    const std::size_t words = (padded_width + word_bits - 1) / word_bits;
+
+    //A copy with its top left at world x, y starts at padded x + 1 - offset, y + 1 - offset
+    const std::size_t offset = isolated ? 1 : 0;
+
+    std::mutex results_mutex;
+    std::vector<std::pair<std::size_t, std::vector<Match>>> bands;
+
+    GridMemory::for_each_band(padded_height, padded_width, [&](const std::size_t first, const std::size_t last) {
+        //Packed rows have spare words on the end so shifts can read past the last column
+        const std::size_t packed_words = words + widest / word_bits + 2;
+        std::vector<Word> alive(packed_words), dead(packed_words);
+        std::vector<Word> ring(depth * rows.size() * words);
+        std::vector<Word> accumulated(words);
+        std::vector<Match> found;
+
+        //Works out the match words of every distinct row against padded row r, into its slot of the ring
+        auto match_row = [&](const std::size_t r) {
+            std::fill(alive.begin(), alive.end(), 0);
+            if (r > 0 && r <= height) {
+                const Cell *cells = world.row(r - 1, Grid::unchecked);
+                for (std::size_t x = 0; x < width; x++) {
+                    alive[(x + 1) / word_bits] |= static_cast<Word>(cells[x] == Cell::ALIVE) << ((x + 1) % word_bits);
+                }
+            }
+            for (std::size_t k = 0; k < packed_words; k++) {
+                dead[k] = ~alive[k];
+            }
+
+            Word *slot = ring.data() + (r % depth) * rows.size() * words;
+            for (std::size_t d = 0; d < rows.size(); d++) {
+                Word *out = slot + d * words;
+                std::fill(out, out + words, ~Word(0));
+                for (std::size_t j = 0; j < rows[d].size(); j++) {
+                    //Bit x of the shifted row is the cell j to the right of column x
+                    const Word *source = (static_cast<Cell>(rows[d][j]) == Cell::ALIVE ? alive : dead).data();
+                    const std::size_t skip = j / word_bits, shift = j % word_bits;
+                    for (std::size_t k = 0; k < words; k++) {
+                        const Word low = source[k + skip];
+                        out[k] &= shift ? (low >> shift) | (source[k + skip + 1] << (word_bits - shift)) : low;
+                    }
+                }
+            }
+        };
+
+        std::size_t ready = first;
+        for (std::size_t y = first; y < last; y++) {
+            //Make sure the rows every orientation starting here needs are in the ring
+            const std::size_t needed = std::min(y + depth, padded_height);
+            for (; ready < needed; ready++) {
+                match_row(ready);
+            }
+
+            for (const auto& orientation : orientations) {
+                const std::size_t lowest = 1 - offset;
+                const std::size_t rows_spanned = orientation.rows.size();
+                if (y < lowest || y + rows_spanned > padded_height ||
+                    y - lowest > height - orientation.height) {
+                    continue;
+                }
+
+                std::fill(accumulated.begin(), accumulated.end(), ~Word(0));
+                for (std::size_t i = 0; i < rows_spanned; i++) {
+                    const Word *match = ring.data() + (((y + i) % depth) * rows.size() + orientation.rows[i]) * words;
+                    for (std::size_t k = 0; k < words; k++) {
+                        accumulated[k] &= match[k];
+                    }
+                }
+
+                //Only starting columns that keep the whole pattern inside the world are wanted
+                const std::size_t x_first = lowest;
+                const std::size_t x_last = lowest + (width - orientation.width);
+                for (std::size_t k = x_first / word_bits; k <= x_last / word_bits; k++) {
+                    Word bits = accumulated[k];
+                    while (bits) {
+                        const std::size_t x = k * word_bits + static_cast<std::size_t>(__builtin_ctzll(bits));
+                        bits &= bits - 1;
+                        if (x < x_first || x > x_last) {
+                            continue;
+                        }
+                        found.push_back(Match{x - lowest, y - lowest, orientation.width, orientation.height,
+                                              orientation.pattern, orientation.rotation, orientation.mirrored});
+                    }
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(results_mutex);
+        bands.emplace_back(first, std::move(found));
+    });
+
+    //Bands finish in any order, put them back in row order and each row's matches in column order
+    std::sort(bands.begin(), bands.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<Match> matches;
+    for (auto& band : bands) {
+        std::stable_sort(band.second.begin(), band.second.end(), [](const Match& a, const Match& b) {
+            return a.y != b.y ? a.y < b.y : a.x < b.x;
+        });
+        matches.insert(matches.end(), band.second.begin(), band.second.end());
+    }
+    return matches;
+}
@@ -0,0 +1,35 @@
+/**
+ * Declares a PatternMatch namespace for finding every copy of a pattern in a world, in any orientation.
+ * Rich documentation for the api and behaviour the PatternMatch namespace can be found in pattern_match.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "grid.h"
+
+/**
+ * Declare the interface of the PatternMatch namespace, which compares 64 cells at a time using bit-packed rows.
+ */
+namespace PatternMatch {
+    //Where a pattern was found. The pattern was mirrored left to right if mirrored is set, then turned clockwise
+    //by rotation quarter turns as Grid::rotate does, and its top left cell is at x, y in the world
+    struct Match {
+        std::size_t x;
+        std::size_t y;
+        std::size_t width;
+        std::size_t height;
+        std::size_t pattern;
+        int rotation;
+        bool mirrored;
+    };
+
+    //Finds every copy of the pattern in all 8 orientations. If isolated, the cells around a copy must be dead too
+    std::vector<Match> find_pattern(const Grid& world, const Grid& pattern, bool isolated = false);
+
+    //Finds every copy of any of the patterns in one pass over the world, such as every phase of a spaceship
+    std::vector<Match> find_patterns(const Grid& world, const std::vector<Grid>& patterns, bool isolated = false);
+};
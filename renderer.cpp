@@ -0,0 +1,210 @@
+/**
+ * Implements a class for drawing grids to a terminal quickly, one whole frame at a time.
+ *      - Frames look exactly like operator<<(std::ostream&, const Grid&), optionally preceded by a caption.
+ *      - Each frame is formatted into a buffer that is reused between frames, then handed to the stream in a
+ *        single write instead of a write per cell and a flush per row.
+ *
+ *      - In ANSI mode the first frame clears the screen, later frames move the cursor back over the previous
+ *        frame and only redraw the lines that changed. Stable regions of a world cost nothing to redraw.
+ *
+ *      - A viewport restricts drawing to a window of the grid, so a small part of a huge world can be watched
+ *        without formatting the rest of it.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "renderer.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * Renderer::Renderer(ansi = false)
+ *
+ * Construct a renderer with no viewport, drawing whole grids.
+ *
+ * @example
+ *
+ *      // Redraw a world in place every step
+ *      Renderer renderer(true);
+ *      for (int i = 0; i < 100; i++) {
+ *          world.step();
+ *          renderer.render(std::cout, world.get_state(), "Step " + std::to_string(i + 1));
+ *      }
+ *
+ * @param ansi
+ *      Optional parameter. If true then frames are redrawn in place using ANSI escape codes. Defaults to false.
+ */
+Renderer::Renderer(const bool ansi) : ansi(ansi), view_x(0), view_y(0), view_width(0), view_height(0){}
+
+/**
+ * Renderer::set_viewport(x, y, width, height)
+ *
+ * Only draw the window of the grid with its top left corner at x, y. The window is clamped to the grid
+ * when a frame is drawn, so it is fine for it to hang off the edge or for the grid to change size.
+ *
+ * @param x
+ *      The x coordinate of the left edge of the window.
+ *
+ * @param y
+ *      The y coordinate of the top edge of the window.
+ *
+ * @param width
+ *      The width of the window, 0 draws to the right edge of the grid.
+ *
+ * @param height
+ *      The height of the window, 0 draws to the bottom edge of the grid.
+ */
+void Renderer::set_viewport(const std::size_t x, const std::size_t y,
+                            const std::size_t width, const std::size_t height) {
+    view_x = x;
+    view_y = y;
+    view_width = width;
+    view_height = height;
+}
+
+/**
+ * Renderer::clear_viewport()
+ *
+ * Go back to drawing whole grids.
+ */
+void Renderer::clear_viewport() {
+    set_viewport(0, 0, 0, 0);
+}
+
+/**
+ * Renderer::format(grid, caption = "")
+ *
+ * Format a frame into the internal buffer in a single pass. The buffer keeps its capacity between frames
+ * so formatting a frame the same size as the last one does not allocate.
+ *
+ * @param grid
+ *      The grid or view to format, only the part within the viewport is read.
+ *
+ * @param caption
+ *      Optional parameter. Text to put above the grid, which may span several lines separated by newlines,
+ *      left out if empty.
+ *
+ * @return
+ *      A read-only reference to the formatted frame, valid until the next call.
+ */
+const std::string& Renderer::format(const GridView& grid, const std::string& caption) {
+    //Clamp the viewport to the grid
+    const std::size_t x0 = std::min(view_x, grid.get_width());
+    const std::size_t y0 = std::min(view_y, grid.get_height());
+    const std::size_t x1 = (view_width == 0) ? grid.get_width() : std::min(grid.get_width(), x0 + view_width);
+    const std::size_t y1 = (view_height == 0) ? grid.get_height() : std::min(grid.get_height(), y0 + view_height);
+    const std::size_t width = x1 - x0;
+    const GridView window = grid.crop(x0, y0, x1, y1);
+
+    frame.clear();
+    lines.clear();
+    frame.reserve(caption.size() + 1 + (width + 3) * (y1 - y0 + 2));
+
+    //A caption may span several lines, each is tracked on its own so ANSI mode redraws only the ones that change
+    if (!caption.empty()){
+        std::size_t start = 0, end;
+        while ((end = caption.find('\n', start)) != std::string::npos){
+            lines.push_back(frame.size());
+            frame.append(caption, start, end - start + 1);
+            start = end + 1;
+        }
+        if (start < caption.size()){
+            lines.push_back(frame.size());
+            frame.append(caption, start, std::string::npos);
+            frame += '\n';
+        }
+    }
+
+    //Top border
+    lines.push_back(frame.size());
+    frame += '+';
+    frame.append(width, '-');
+    frame += "+\n";
+
+    //The cell values are already the characters that get printed, so contiguous rows are copied across whole
+    for (std::size_t i = 0; i < window.get_height(); i++){
+        lines.push_back(frame.size());
+        frame += '|';
+        const Cell *cells = window.row(i);
+        if (cells != nullptr){
+            frame.append(reinterpret_cast<const char *>(cells), width);
+        } else {
+            for (std::size_t j = 0; j < width; j++){
+                frame += static_cast<char>(window(j, i));
+            }
+        }
+        frame += "|\n";
+    }
+
+    //Bottom border
+    lines.push_back(frame.size());
+    frame += '+';
+    frame.append(width, '-');
+    frame += "+\n";
+
+    //One past the end of the last line
+    lines.push_back(frame.size());
+    return frame;
+}
+
+/**
+ * Renderer::render(os, grid, caption = "")
+ *
+ * Format a frame and write it to the stream in one go.
+ *
+ * In ANSI mode only the lines that differ from the previous frame are written, each preceded by an escape
+ * code moving the cursor to it. If the number of lines changed the whole screen is cleared and redrawn.
+ *
+ * @param os
+ *      An ascii mode output stream such as std::cout.
+ *
+ * @param grid
+ *      The grid or view to draw.
+ *
+ * @param caption
+ *      Optional parameter. Text to put above the grid, which may span several lines, left out if empty.
+ */
+void Renderer::render(std::ostream& os, const GridView& grid, const std::string& caption) {
+    format(grid, caption);
+
+    if (!ansi){
+        os.write(frame.data(), frame.size());
+        os.flush();
+        return;
+    }
+
+    output.clear();
+    if (previous_lines.size() != lines.size()){
+        //First frame, or the shape changed, so start from a clear screen
+        output += "\x1b[2J\x1b[H";
+        output += frame;
+    } else {
+        for (std::size_t i = 0; i + 1 < lines.size(); i++){
+            const std::size_t length = lines[i + 1] - lines[i];
+            const std::size_t previous_length = previous_lines[i + 1] - previous_lines[i];
+            if (length == previous_length &&
+                std::memcmp(frame.data() + lines[i], previous.data() + previous_lines[i], length) == 0){
+                continue;
+            }
+
+            //Move to the start of the changed line, draw it without its newline and clear anything left over
+            output += "\x1b[";
+            output += std::to_string(i + 1);
+            output += ";1H";
+            output.append(frame, lines[i], length - 1);
+            output += "\x1b[K";
+        }
+
+        //Leave the cursor underneath the frame
+        output += "\x1b[";
+        output += std::to_string(lines.size());
+        output += ";1H";
+    }
+
+    os.write(output.data(), output.size());
+    os.flush();
+
+    //Keep this frame to compare the next one against, the swap keeps both buffers allocated
+    previous.swap(frame);
+    previous_lines.swap(lines);
+}
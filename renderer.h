@@ -0,0 +1,54 @@
+/**
+ * Declares a class for drawing grids to a terminal quickly, one whole frame at a time.
+ * Rich documentation for the api and behaviour the Renderer class can be found in renderer.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "grid.h"
+#include "grid_view.h"
+
+/**
+ * Declare the structure of the Renderer class for formatting frames into a reusable buffer.
+ *
+ * In ANSI mode the previous frame is kept so only the rows that changed are redrawn.
+ */
+class Renderer {
+private:
+    bool ansi;
+
+    //The window of the grid to draw, a width or height of 0 means the whole grid
+    std::size_t view_x;
+    std::size_t view_y;
+    std::size_t view_width;
+    std::size_t view_height;
+
+    //The frame being built, the last frame drawn and the bytes actually sent to the stream
+    std::string frame;
+    std::string previous;
+    std::string output;
+
+    //Where each line of the frame starts, so lines can be compared against the previous frame
+    std::vector<std::size_t> lines;
+    std::vector<std::size_t> previous_lines;
+
+public:
+    //Renders in plain mode by default, ANSI mode redraws in place and only what changed
+    explicit Renderer(bool ansi = false);
+
+    //Restricts drawing to a window of the grid, clamped to the grid if it hangs off the edge
+    void set_viewport(std::size_t x, std::size_t y, std::size_t width, std::size_t height);
+    void clear_viewport();
+
+    //Anything that can be viewed can be drawn, including rotated or reflected views of a grid
+    //Formats a frame into the internal buffer and returns it without drawing anything
+    const std::string& format(const GridView& grid, const std::string& caption = "");
+
+    //Formats a frame and writes it to the stream with a single write
+    void render(std::ostream& os, const GridView& grid, const std::string& caption = "");
+};
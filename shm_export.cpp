@@ -0,0 +1,440 @@
+/**
+ * Implements an exporter that writes generations into a POSIX shared memory ring of bit-packed frames, and a
+ * reader that other processes use to attach to it.
+ *      - External viewers and analysers map the ring and read frames straight out of it, with no copies, no
+ *        pipes and no text formatting. Packing one bit per cell makes a frame an eighth the size of a Grid.
+ *      - The shared memory starts with a ShmLayout::Header giving the dimensions, the number of frames in the
+ *        ring and how many frames have been written. Each frame has its own header with the generation number,
+ *        the alive count and a sequence lock.
+ *      - The writer makes a frame's sequence odd, writes the frame, then makes it even again and bumps the count
+ *        of frames written. A reader notes the sequence, reads what it needs, and checks the sequence has not
+ *        changed. Since the writer fills the ring in turn, a reader has frame_count - 1 writes to finish with a
+ *        frame before it can be overwritten.
+ *      - The writer never waits for readers, and readers never write to the shared memory at all.
+ *      - A name already in use is refused rather than overwritten, since clearing a ring readers have mapped would
+ *        pull it out from under them. Taking over the name instead unlinks it and creates a new object, so
+ *        anything still attached to the old one keeps it intact.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "shm_export.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "snapshot.h"
+
+namespace {
+    //Shared memory object names need a single leading slash
+    std::string object_name(const std::string& name) {
+        return (!name.empty() && name[0] == '/') ? name : "/" + name;
+    }
+}
+
+/**
+ * ShmLayout::row_bytes(width)
+ *
+ * @return
+ *      The number of bytes in one bit-packed row, a whole number of 64 bit words.
+ */
+std::uint64_t ShmLayout::row_bytes(const std::uint64_t width) {
+    return (width + 63) / 64 * sizeof(std::uint64_t);
+}
+
+/**
+ * ShmLayout::frame_bytes(width, height)
+ *
+ * @return
+ *      The number of bytes in one frame including its header, a whole number of cache lines.
+ */
+std::uint64_t ShmLayout::frame_bytes(const std::uint64_t width, const std::uint64_t height) {
+    const std::uint64_t bytes = sizeof(FrameHeader) + row_bytes(width) * height;
+    return (bytes + 63) / 64 * 64;
+}
+
+/**
+ * ShmExporter::ShmExporter(name, width, height, frames = 8, unlink_on_close = true, take_over = false)
+ *
+ * Create the shared memory object /name and lay out an empty ring in it.
+ *
+ * @example
+ *
+ *      // Export every generation of a running world for a viewer to pick up as "gol"
+ *      ShmExporter exporter("gol", world.get_width(), world.get_height());
+ *      for (std::size_t i = 0; i < steps; i++){
+ *          world.step();
+ *          exporter.write(world.get_state(), world.get_generation());
+ *      }
+ *
+ * @param name
+ *      The name of the shared memory object, with or without the leading slash.
+ *
+ * @param width
+ *      The width of the grids that will be written.
+ *
+ * @param height
+ *      The height of the grids that will be written.
+ *
+ * @param frames
+ *      Optional parameter. The number of frames in the ring. Defaults to 8.
+ *
+ * @param unlink_on_close
+ *      Optional parameter. Whether to remove the name when the exporter is destroyed, unless another exporter
+ *      has taken it over since. Readers already attached keep their mapping either way. Defaults to true.
+ *
+ * @param take_over
+ *      Optional parameter. If true and the name is already in use, for example left behind by an exporter that
+ *      crashed, it is unlinked and a new object made in its place. Defaults to false.
+ *
+ * @throws
+ *      std::logic_error if frames is less than 2.
+ *      std::runtime_error if the name is already in use and take_over is false, or the shared memory object
+ *      cannot be created, sized or mapped.
+ */
+ShmExporter::ShmExporter(const std::string& name, const std::size_t width, const std::size_t height,
+                         const std::size_t frames, const bool unlink_on_close, const bool take_over) :
+        name(object_name(name)),
+        unlink_on_close(unlink_on_close),
+        descriptor(-1),
+        memory(nullptr),
+        length(0),
+        header(nullptr) {
+    if (frames < 2){
+        throw std::logic_error("A shared memory ring needs at least 2 frames");
+    }
+    length = sizeof(ShmLayout::Header) + frames * ShmLayout::frame_bytes(width, height);
+
+    //Never reuse an existing object, its readers would see the ring cleared and resized underneath them
+    descriptor = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (descriptor < 0 && errno == EEXIST && take_over){
+        shm_unlink(this->name.c_str());
+        descriptor = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (descriptor < 0){
+        if (errno == EEXIST){
+            throw std::runtime_error("The shared memory object " + this->name + " is already in use");
+        }
+        throw std::runtime_error("Could not create the shared memory object " + this->name);
+    }
+    if (ftruncate(descriptor, static_cast<off_t>(length)) != 0){
+        close(descriptor);
+        shm_unlink(this->name.c_str());
+        throw std::runtime_error("Could not size the shared memory object " + this->name);
+    }
+    memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    if (memory == MAP_FAILED){
+        close(descriptor);
+        shm_unlink(this->name.c_str());
+        throw std::runtime_error("Could not map the shared memory object " + this->name);
+    }
+
+    //Fill in the header last of all, with no frames written, so a reader never sees a half made ring
+    std::memset(memory, 0, length);
+    header = new (memory) ShmLayout::Header();
+    header->version = ShmLayout::version;
+    header->frame_count = static_cast<std::uint32_t>(frames);
+    header->width = width;
+    header->height = height;
+    header->row_bytes = ShmLayout::row_bytes(width);
+    header->frame_bytes = ShmLayout::frame_bytes(width, height);
+    header->frames_written.store(0, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < frames; i++){
+        new (frame(i)) ShmLayout::FrameHeader();
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, ShmLayout::magic, sizeof(ShmLayout::magic));
+}
+
+/**
+ * ShmExporter::~ShmExporter()
+ *
+ * Unmap the ring, and remove its name if asked to and the name still refers to this exporter's object.
+ */
+ShmExporter::~ShmExporter() {
+    munmap(memory, length);
+    if (unlink_on_close){
+        //If another exporter has taken the name over, the object it refers to is theirs to remove
+        struct stat mine, named;
+        const int current = shm_open(name.c_str(), O_RDONLY, 0);
+        if (current >= 0){
+            if (fstat(descriptor, &mine) == 0 && fstat(current, &named) == 0 &&
+                mine.st_dev == named.st_dev && mine.st_ino == named.st_ino){
+                shm_unlink(name.c_str());
+            }
+            close(current);
+        }
+    }
+    close(descriptor);
+}
+
+/**
+ * ShmExporter::frame(index)
+ *
+ * Private helper giving the header of a frame in the ring, which the frame's bits follow.
+ */
+ShmLayout::FrameHeader* ShmExporter::frame(const std::size_t index) const {
+    char *base = static_cast<char *>(memory) + sizeof(ShmLayout::Header);
+    return reinterpret_cast<ShmLayout::FrameHeader *>(base + index * header->frame_bytes);
+}
+
+/**
+ * ShmExporter::write(state, generation)
+ *
+ * Bit-pack a generation into the next frame of the ring, under the frame's sequence lock.
+ *
+ * @param state
+ *      The grid to write, which must have the size the exporter was made for.
+ *
+ * @param generation
+ *      The generation number readers will see with it.
+ *
+ * @throws
+ *      std::logic_error if the grid is not the size the exporter was made for.
+ */
+void ShmExporter::write(const Grid& state, const std::uint64_t generation) {
+    if (state.get_width() != header->width || state.get_height() != header->height){
+        throw std::logic_error("The grid is not the size the shared memory ring was made for");
+    }
+
+    const std::uint64_t written = header->frames_written.load(std::memory_order_relaxed);
+    ShmLayout::FrameHeader *target = frame(written % header->frame_count);
+    std::uint64_t *bits = reinterpret_cast<std::uint64_t *>(target + 1);
+
+    //Odd while writing, the fence keeping the writes of the frame after it
+    const std::uint64_t sequence = target->sequence.load(std::memory_order_relaxed);
+    target->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const std::size_t width = state.get_width();
+    const std::size_t words = header->row_bytes / sizeof(std::uint64_t);
+    std::uint64_t alive = 0;
+    for (std::size_t y = 0; y < state.get_height(); y++){
+        const Cell *row = state.row(y, Grid::unchecked);
+        std::uint64_t *out = bits + y * words;
+        for (std::size_t w = 0; w < words; w++){
+            //Pack 64 cells into a word, the last word of a row padded with dead cells
+            std::uint64_t word = 0;
+            const std::size_t end = std::min(width, (w + 1) * 64);
+            for (std::size_t x = w * 64; x < end; x++){
+                word |= static_cast<std::uint64_t>(row[x] == Cell::ALIVE) << (x % 64);
+            }
+            out[w] = word;
+            alive += static_cast<std::uint64_t>(__builtin_popcountll(word));
+        }
+    }
+    target->generation = generation;
+    target->alive = alive;
+
+    target->sequence.store(sequence + 2, std::memory_order_release);
+    header->frames_written.store(written + 1, std::memory_order_release);
+}
+
+/**
+ * ShmExporter::write(snapshot)
+ *
+ * Write a published generation into the next frame of the ring, so the export can run on its own thread.
+ *
+ * @param snapshot
+ *      The snapshot to write, which must not be empty.
+ *
+ * @throws
+ *      std::logic_error if the snapshot is empty or not the size the exporter was made for.
+ */
+void ShmExporter::write(const Snapshot& snapshot) {
+    write(snapshot.get_state(), snapshot.get_generation());
+}
+
+/**
+ * ShmExporter::get_frames_written()
+ *
+ * @return
+ *      How many frames have been written since the ring was made.
+ */
+std::uint64_t ShmExporter::get_frames_written() const {
+    return header->frames_written.load(std::memory_order_relaxed);
+}
+
+/**
+ * ShmReader::ShmReader(name)
+ *
+ * Attach to the ring an exporter made, mapping it read-only.
+ *
+ * @example
+ *
+ *      // Print the population of the newest frame of a running simulation
+ *      ShmReader reader("gol");
+ *      ShmReader::Frame frame;
+ *      if (reader.latest(frame) && reader.valid(frame)){
+ *          std::cout << frame.generation << ": " << frame.alive << std::endl;
+ *      }
+ *
+ * @param name
+ *      The name the exporter was given, with or without the leading slash.
+ *
+ * @throws
+ *      std::runtime_error if the shared memory object cannot be opened or mapped, or does not hold a ring.
+ */
+ShmReader::ShmReader(const std::string& name) : descriptor(-1), memory(nullptr), length(0), header(nullptr) {
+    const std::string object = object_name(name);
+    descriptor = shm_open(object.c_str(), O_RDONLY, 0);
+    if (descriptor < 0){
+        throw std::runtime_error("Could not open the shared memory object " + object);
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(ShmLayout::Header)){
+        close(descriptor);
+        throw std::runtime_error("The shared memory object " + object + " is not a frame ring");
+    }
+    length = static_cast<std::size_t>(status.st_size);
+    memory = mmap(nullptr, length, PROT_READ, MAP_SHARED, descriptor, 0);
+    if (memory == MAP_FAILED){
+        close(descriptor);
+        throw std::runtime_error("Could not map the shared memory object " + object);
+    }
+
+    header = static_cast<const ShmLayout::Header *>(memory);
+    if (std::memcmp(header->magic, ShmLayout::magic, sizeof(ShmLayout::magic)) != 0 ||
+        header->version != ShmLayout::version ||
+        length < sizeof(ShmLayout::Header) + header->frame_count * header->frame_bytes){
+        munmap(const_cast<void *>(memory), length);
+        close(descriptor);
+        throw std::runtime_error("The shared memory object " + object + " is not a frame ring");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+}
+
+/**
+ * ShmReader::~ShmReader()
+ *
+ * Detach from the ring.
+ */
+ShmReader::~ShmReader() {
+    munmap(const_cast<void *>(memory), length);
+    close(descriptor);
+}
+
+/**
+ * ShmReader::get_width()
+ *
+ * @return
+ *      The width of the frames.
+ */
+std::size_t ShmReader::get_width() const {
+    return header->width;
+}
+
+/**
+ * ShmReader::get_height()
+ *
+ * @return
+ *      The height of the frames.
+ */
+std::size_t ShmReader::get_height() const {
+    return header->height;
+}
+
+/**
+ * ShmReader::get_frames_written()
+ *
+ * @return
+ *      How many frames the exporter has written, which only ever goes up while it runs.
+ */
+std::uint64_t ShmReader::get_frames_written() const {
+    return header->frames_written.load(std::memory_order_acquire);
+}
+
+/**
+ * ShmReader::latest(frame)
+ *
+ * Find the newest complete frame. The frame is read in place, so once it has been used ShmReader::valid must
+ * be called to check the writer did not come round the ring and start overwriting it in the meantime.
+ *
+ * @param frame
+ *      Set to the newest frame.
+ *
+ * @return
+ *      Whether there was a frame, false until the exporter has written one.
+ */
+bool ShmReader::latest(Frame &frame) const {
+    while (true){
+        const std::uint64_t written = header->frames_written.load(std::memory_order_acquire);
+        if (written == 0){
+            return false;
+        }
+
+        frame.index = static_cast<std::size_t>((written - 1) % header->frame_count);
+        const char *base = static_cast<const char *>(memory) + sizeof(ShmLayout::Header);
+        const auto *target = reinterpret_cast<const ShmLayout::FrameHeader *>(base + frame.index * header->frame_bytes);
+        frame.sequence = target->sequence.load(std::memory_order_acquire);
+        if (frame.sequence % 2 != 0){
+            //The writer has already come all the way round the ring, look again
+            continue;
+        }
+        frame.generation = target->generation;
+        frame.alive = target->alive;
+        frame.bits = reinterpret_cast<const std::uint64_t *>(target + 1);
+        return true;
+    }
+}
+
+/**
+ * ShmReader::valid(frame)
+ *
+ * Check a frame was not touched by the writer since ShmReader::latest found it, so everything read from it
+ * since is consistent.
+ *
+ * @param frame
+ *      The frame to check.
+ *
+ * @return
+ *      Whether the frame is still the one that was found.
+ */
+bool ShmReader::valid(const Frame &frame) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const char *base = static_cast<const char *>(memory) + sizeof(ShmLayout::Header);
+    const auto *target = reinterpret_cast<const ShmLayout::FrameHeader *>(base + frame.index * header->frame_bytes);
+    return target->sequence.load(std::memory_order_relaxed) == frame.sequence;
+}
+
+/**
+ * ShmReader::get(frame, x, y)
+ *
+ * Read a single cell of a frame in place.
+ *
+ * @throws
+ *      std::out_of_range if x, y is not a valid coordinate within the frame.
+ */
+Cell ShmReader::get(const Frame &frame, const std::size_t x, const std::size_t y) const {
+    if (x >= header->width || y >= header->height){
+        throw std::out_of_range("Incorrect values provided");
+    }
+    const std::uint64_t word = frame.bits[y * (header->row_bytes / sizeof(std::uint64_t)) + x / 64];
+    return ((word >> (x % 64)) & 1) ? Cell::ALIVE : Cell::DEAD;
+}
+
+/**
+ * ShmReader::to_grid(frame)
+ *
+ * Unpack a whole frame into a new grid. Check ShmReader::valid afterwards before trusting the result.
+ *
+ * @return
+ *      A grid holding the frame.
+ */
+Grid ShmReader::to_grid(const Frame &frame) const {
+    Grid grid(header->width, header->height);
+    const std::size_t words = header->row_bytes / sizeof(std::uint64_t);
+    for (std::size_t y = 0; y < header->height; y++){
+        Cell *row = grid.row(y, Grid::unchecked);
+        const std::uint64_t *bits = frame.bits + y * words;
+        for (std::size_t x = 0; x < header->width; x++){
+            row[x] = ((bits[x / 64] >> (x % 64)) & 1) ? Cell::ALIVE : Cell::DEAD;
+        }
+    }
+    return grid;
+}
@@ -0,0 +1,124 @@
+/**
+ * Declares an exporter that writes generations into a POSIX shared memory ring of bit-packed frames, and a reader
+ * that other processes use to attach to it.
+ * Rich documentation for the api, behaviour and memory layout can be found in shm_export.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "grid.h"
+
+class Snapshot;
+
+/**
+ * The layout of the shared memory, shared by writer and readers, so only fixed size fields and lock-free atomics.
+ * The header is followed by frame_count frames of frame_bytes each, every frame a ShmFrameHeader followed by
+ * height rows of row_bytes, one bit per cell with bit x % 64 of word x / 64 set if the cell is alive.
+ */
+namespace ShmLayout {
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared memory needs address free atomics");
+
+    const char magic[8] = {'G', 'O', 'L', 'S', 'H', 'M', '1', '\0'};
+    const std::uint32_t version = 1;
+
+    struct alignas(64) Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t frame_count;
+        std::uint64_t width;
+        std::uint64_t height;
+        std::uint64_t row_bytes;
+        std::uint64_t frame_bytes;
+
+        //The number of frames written so far, the newest being frame (frames_written - 1) % frame_count
+        std::atomic<std::uint64_t> frames_written;
+    };
+
+    struct alignas(64) FrameHeader {
+        //A sequence lock, odd while the frame is being written
+        std::atomic<std::uint64_t> sequence;
+        std::uint64_t generation;
+        std::uint64_t alive;
+    };
+
+    //The bytes needed for one bit-packed row of width cells, rounded up to whole 64 bit words
+    std::uint64_t row_bytes(std::uint64_t width);
+    std::uint64_t frame_bytes(std::uint64_t width, std::uint64_t height);
+};
+
+/**
+ * Declare the structure of the ShmExporter class, the single writer of a shared memory ring of frames.
+ */
+class ShmExporter {
+private:
+    std::string name;
+    bool unlink_on_close;
+    int descriptor;
+    void *memory;
+    std::size_t length;
+    ShmLayout::Header *header;
+
+    ShmLayout::FrameHeader* frame(std::size_t index) const;
+
+public:
+    //Creates the shared memory object /name sized for width x height grids, failing if the name is in use
+    //unless told to take it over
+    ShmExporter(const std::string& name, std::size_t width, std::size_t height, std::size_t frames = 8,
+                bool unlink_on_close = true, bool take_over = false);
+    ~ShmExporter();
+
+    ShmExporter(const ShmExporter&) = delete;
+    ShmExporter& operator=(const ShmExporter&) = delete;
+
+    //Writes a generation into the next frame of the ring
+    void write(const Grid& state, std::uint64_t generation);
+    void write(const Snapshot& snapshot);
+
+    std::uint64_t get_frames_written() const;
+};
+
+/**
+ * Declare the structure of the ShmReader class, which maps an exporter's ring read-only and reads frames in place.
+ */
+class ShmReader {
+private:
+    int descriptor;
+    const void *memory;
+    std::size_t length;
+    const ShmLayout::Header *header;
+
+public:
+    //A frame read in place, only trustworthy if ShmReader::valid still says so after it has been used
+    struct Frame {
+        const std::uint64_t *bits;
+        std::uint64_t generation;
+        std::uint64_t alive;
+        std::uint64_t sequence;
+        std::size_t index;
+    };
+
+    explicit ShmReader(const std::string& name);
+    ~ShmReader();
+
+    ShmReader(const ShmReader&) = delete;
+    ShmReader& operator=(const ShmReader&) = delete;
+
+    std::size_t get_width() const;
+    std::size_t get_height() const;
+    std::uint64_t get_frames_written() const;
+
+    //Finds the newest complete frame, returning false if there is none yet
+    bool latest(Frame &frame) const;
+
+    //Whether a frame was left alone by the writer while it was being read
+    bool valid(const Frame &frame) const;
+
+    //Reads one cell of a frame, and copies a whole frame out into a grid
+    Cell get(const Frame &frame, std::size_t x, std::size_t y) const;
+    Grid to_grid(const Frame &frame) const;
+};
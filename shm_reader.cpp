@@ -0,0 +1,72 @@
+/**
+ * An example of attaching to a running simulation through the shared memory ring written by ShmExporter.
+ * i.e.
+ * ./Game_of_Life --file glider.gol --steps 100000 --shm gol &
+ * ./shm_reader gol 20 --print
+ *
+ * Prints the generation and population of each new frame, and optionally the frame itself, until it has seen
+ * the requested number of frames or the simulation stops writing them.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "shm_export.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " name [frames] [--print]" << std::endl;
+        return -1;
+    }
+    const std::string name = argv[1];
+    const unsigned long frames = (argc > 2 && argv[2][0] != '-') ? std::strtoul(argv[2], nullptr, 10) : 10;
+    const bool print = std::strcmp(argv[argc - 1], "--print") == 0;
+
+    try {
+        ShmReader reader(name);
+        std::cout << "Attached to " << name << ", " << reader.get_width() << "x" << reader.get_height() << std::endl;
+
+        // Poll for new frames, giving up once nothing new has been written for a couple of seconds
+        std::uint64_t last_generation = 0;
+        bool seen_any = false;
+        unsigned long seen = 0;
+        auto last_frame = std::chrono::steady_clock::now();
+        while (seen < frames && std::chrono::steady_clock::now() - last_frame < std::chrono::seconds(2)) {
+            ShmReader::Frame frame;
+            if (!reader.latest(frame) || (seen_any && frame.generation == last_generation)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+
+            // Read everything needed from the frame in place, then make sure the writer left it alone meanwhile
+            const Grid grid = print ? reader.to_grid(frame) : Grid();
+            const std::uint64_t generation = frame.generation;
+            const std::uint64_t alive = frame.alive;
+            if (!reader.valid(frame)) {
+                continue;
+            }
+
+            std::cout << "Generation " << generation << " | Alive " << alive << std::endl;
+            if (print) {
+                std::cout << grid << std::endl;
+            }
+            last_generation = generation;
+            seen_any = true;
+            seen++;
+            last_frame = std::chrono::steady_clock::now();
+        }
+    }
+    catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
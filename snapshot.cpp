@@ -0,0 +1,246 @@
+/**
+ * Implements a SnapshotPublisher that hands completed generations of a world to reader threads without locks.
+ *      - World::get_state returns the grid the world is about to step into next, so other threads cannot read it
+ *        safely. A publisher gives them copies that never change while they are held instead.
+ *      - The publisher owns a fixed ring of grids, each with an atomic count of its references. A slot is only
+ *        written when it has no references at all, and is claimed by atomically taking its count from 0 to 1.
+ *      - The latest slot holds a reference of its own, given up when a newer generation is published.
+ *      - A reader takes a reference on the latest slot and then checks it is still the latest. If a newer
+ *        generation was published in between it lets go and tries again, so it never reads a slot being written.
+ *      - Once the grids have their size nothing is allocated, publishing copies rows into an existing grid.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "snapshot.h"
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * Snapshot::Snapshot()
+ *
+ * Construct an empty snapshot.
+ */
+Snapshot::Snapshot() : publisher(nullptr), slot(0){}
+
+/**
+ * Snapshot::Snapshot(publisher, slot)
+ *
+ * Private constructor taking over a reference the publisher has already counted.
+ */
+Snapshot::Snapshot(SnapshotPublisher *publisher, const std::size_t slot) : publisher(publisher), slot(slot){}
+
+/**
+ * Snapshot::~Snapshot()
+ *
+ * Release the snapshot, letting the grid be reused once no other snapshot holds it.
+ */
+Snapshot::~Snapshot() {
+    release();
+}
+
+/**
+ * Snapshot::Snapshot(other)
+ *
+ * Move a snapshot, leaving the other one empty.
+ */
+Snapshot::Snapshot(Snapshot&& other) noexcept : publisher(other.publisher), slot(other.slot) {
+    other.publisher = nullptr;
+}
+
+/**
+ * Snapshot::operator=(other)
+ *
+ * Release this snapshot and take over another, leaving the other one empty.
+ */
+Snapshot& Snapshot::operator=(Snapshot&& other) noexcept {
+    if (this != &other){
+        release();
+        publisher = other.publisher;
+        slot = other.slot;
+        other.publisher = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * Snapshot::operator bool()
+ *
+ * @return
+ *      Whether the snapshot holds a generation.
+ */
+Snapshot::operator bool() const {
+    return publisher != nullptr;
+}
+
+/**
+ * Snapshot::get_state()
+ *
+ * @return
+ *      A read-only reference to the published grid, valid until the snapshot is released.
+ *
+ * @throws
+ *      std::logic_error if the snapshot is empty.
+ */
+const Grid& Snapshot::get_state() const {
+    if (publisher == nullptr){
+        throw std::logic_error("The snapshot is empty");
+    }
+    return publisher->slots[slot].state;
+}
+
+/**
+ * Snapshot::get_generation()
+ *
+ * @return
+ *      The generation number the grid was published with.
+ *
+ * @throws
+ *      std::logic_error if the snapshot is empty.
+ */
+std::uint64_t Snapshot::get_generation() const {
+    if (publisher == nullptr){
+        throw std::logic_error("The snapshot is empty");
+    }
+    return publisher->slots[slot].generation;
+}
+
+/**
+ * Snapshot::release()
+ *
+ * Give the grid back to the publisher, leaving the snapshot empty. Does nothing if it is already empty.
+ */
+void Snapshot::release() {
+    if (publisher != nullptr){
+        //Release so every read of the grid happens before the publisher can claim it again
+        publisher->slots[slot].references.fetch_sub(1, std::memory_order_release);
+        publisher = nullptr;
+    }
+}
+
+/**
+ * SnapshotPublisher::SnapshotPublisher(slots = 4)
+ *
+ * Construct a publisher with a fixed number of slots. One slot is always the latest generation and one is
+ * needed to write the next, so readers can hold slots - 2 older generations before publications get skipped.
+ *
+ * @example
+ *
+ *      // Let a renderer thread draw whatever the latest generation is, without slowing the simulation down
+ *      SnapshotPublisher publisher;
+ *      world.set_snapshot_publisher(&publisher);
+ *
+ *      std::thread renderer([&publisher]() {
+ *          while (running){
+ *              Snapshot snapshot = publisher.acquire();
+ *              if (snapshot){
+ *                  draw(snapshot.get_state(), snapshot.get_generation());
+ *              }
+ *          }
+ *      });
+ *
+ * @param slots
+ *      Optional parameter. The number of grids in the ring. Defaults to 4.
+ *
+ * @throws
+ *      std::logic_error if there are fewer than 2 slots.
+ */
+SnapshotPublisher::SnapshotPublisher(const std::size_t slots) :
+        slots(new Slot[slots]),
+        slot_count(slots),
+        latest(slots),
+        skipped(0) {
+    if (slots < 2){
+        throw std::logic_error("A snapshot publisher needs at least 2 slots");
+    }
+    for (std::size_t i = 0; i < slots; i++){
+        this->slots[i].generation = 0;
+        this->slots[i].references.store(0);
+    }
+}
+
+/**
+ * SnapshotPublisher::publish(state, generation)
+ *
+ * Copy a generation into a free slot and make it the latest. Only one thread may publish, usually the one
+ * stepping the world. It never waits for readers: if they hold every other slot the generation is skipped.
+ *
+ * @param state
+ *      The grid to publish.
+ *
+ * @param generation
+ *      The generation number readers will see with it.
+ *
+ * @return
+ *      Whether the generation was published.
+ */
+bool SnapshotPublisher::publish(const Grid& state, const std::uint64_t generation) {
+    const std::size_t current = latest.load(std::memory_order_relaxed);
+
+    //Claim any slot nobody holds, the acquire pairing with the release of the last snapshot of it
+    std::size_t claimed = slot_count;
+    for (std::size_t i = 0; i < slot_count && claimed == slot_count; i++){
+        std::uint32_t expected = 0;
+        if (i != current &&
+            slots[i].references.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)){
+            claimed = i;
+        }
+    }
+    if (claimed == slot_count){
+        skipped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    //Copy the rows into the slot, which only allocates if the size has changed
+    Slot &slot = slots[claimed];
+    if (slot.state.get_width() != state.get_width() || slot.state.get_height() != state.get_height()){
+        slot.state = Grid(state.get_width(), state.get_height());
+    }
+    for (std::size_t y = 0; y < state.get_height(); y++){
+        std::memcpy(slot.state.row(y, Grid::unchecked), state.row(y, Grid::unchecked), state.get_width() * sizeof(Cell));
+    }
+    slot.generation = generation;
+
+    //Make it the latest, keeping the reference taken when claiming it, and drop the old latest's reference
+    latest.store(claimed, std::memory_order_release);
+    if (current != slot_count){
+        slots[current].references.fetch_sub(1, std::memory_order_release);
+    }
+    return true;
+}
+
+/**
+ * SnapshotPublisher::acquire()
+ *
+ * Take a snapshot of the latest generation. Safe to call from any number of threads at once, and never waits
+ * for the publisher.
+ *
+ * @return
+ *      A snapshot of the latest generation, or an empty snapshot if nothing has been published yet.
+ */
+Snapshot SnapshotPublisher::acquire() {
+    while (true){
+        const std::size_t slot = latest.load(std::memory_order_acquire);
+        if (slot == slot_count){
+            return Snapshot();
+        }
+
+        //Only keep the reference if the slot was still the latest once it was counted, otherwise the publisher
+        //may have claimed it before the reference was taken
+        slots[slot].references.fetch_add(1, std::memory_order_acq_rel);
+        if (latest.load(std::memory_order_acquire) == slot){
+            return Snapshot(this, slot);
+        }
+        slots[slot].references.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+/**
+ * SnapshotPublisher::get_skipped()
+ *
+ * @return
+ *      How many generations have not been published because readers were holding every slot.
+ */
+std::uint64_t SnapshotPublisher::get_skipped() const {
+    return skipped.load(std::memory_order_relaxed);
+}
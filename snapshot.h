@@ -0,0 +1,93 @@
+/**
+ * Declares a SnapshotPublisher that hands completed generations of a world to reader threads without locks.
+ * Rich documentation for the api and behaviour of the SnapshotPublisher and Snapshot classes can be found in
+ * snapshot.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "grid.h"
+
+class SnapshotPublisher;
+
+/**
+ * Declare the structure of the Snapshot class, a reader's hold on one published generation.
+ *
+ * The grid it refers to is immutable for as long as the snapshot is held, and goes back to the publisher to be
+ * reused when the last snapshot of it is released.
+ */
+class Snapshot {
+private:
+    friend class SnapshotPublisher;
+
+    SnapshotPublisher *publisher;
+    std::size_t slot;
+
+    Snapshot(SnapshotPublisher *publisher, std::size_t slot);
+
+public:
+    //An empty snapshot, also what acquiring gives before anything has been published
+    Snapshot();
+    ~Snapshot();
+
+    Snapshot(Snapshot&& other) noexcept;
+    Snapshot& operator=(Snapshot&& other) noexcept;
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    explicit operator bool() const;
+    const Grid& get_state() const;
+    std::uint64_t get_generation() const;
+
+    //Gives the grid back early, leaving the snapshot empty
+    void release();
+};
+
+/**
+ * Declare the structure of the SnapshotPublisher class, a fixed ring of grids with atomic reference counts.
+ *
+ * One thread publishes by copying a generation into a free grid and making it the latest. Any number of threads
+ * acquire the latest as a Snapshot. If readers are holding every grid the publication is skipped, so readers
+ * can never make the publishing thread wait.
+ */
+class SnapshotPublisher {
+private:
+    friend class Snapshot;
+
+    struct Slot {
+        Grid state;
+        std::uint64_t generation;
+
+        //Held snapshots, plus one while the slot is the latest or being written
+        std::atomic<std::uint32_t> references;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t slot_count;
+
+    //The slot holding the latest generation, or slot_count before the first publication
+    std::atomic<std::size_t> latest;
+
+    //How many publications have been skipped because every slot was held
+    std::atomic<std::uint64_t> skipped;
+
+public:
+    //More slots let readers hold on to snapshots for longer before publications start being skipped
+    explicit SnapshotPublisher(std::size_t slots = 4);
+
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    //Called by the publishing thread, returns false if every slot was held and the generation was skipped
+    bool publish(const Grid& state, std::uint64_t generation);
+
+    //Called by any thread, returns an empty snapshot if nothing has been published yet
+    Snapshot acquire();
+
+    std::uint64_t get_skipped() const;
+};
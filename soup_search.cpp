@@ -0,0 +1,789 @@
+/**
+ * Implements a search that runs random soups to stabilisation and takes a census of the objects left behind.
+ *      - Soups are generated by a counter based generator, so soup n depends only on the seed and n. Each call
+ *        hashes the counter with the SplitMix64 finaliser and fills 64 cells from the result.
+ *      - Each soup is placed in the middle of a field with a margin of dead cells. Only the bounding box of the
+ *        live cells, plus one cell around it, is stepped each generation, and the population and new bounding
+ *        box are worked out from the rows just written.
+ *      - A soup is taken to have stabilised once its population has repeated with some period of at most
+ *        max_period for 2 * max_period generations.
+ *      - Every so often, and whenever something reaches the edge of the field, groups of cells that are clear
+ *        of all the others on some side are stepped on their own. Spaceships heading further that way are
+ *        counted and removed, which keeps the box small. Anything else that reaches the edge of the field
+ *        makes it grow, and a soup whose field grows too large, or that has not stabilised after
+ *        max_generations, is counted as unstable.
+ *      - The ash of a stabilised soup is split into objects by grouping the cells that are alive in any phase
+ *        of its period with every such cell within 2 of them, so every phase of an oscillator stays in one
+ *        object and objects close enough to affect each other are classified together.
+ *      - Each object is stepped on its own to find its period and how far it moves. Its code is a prefix of xs
+ *        and the population for still lifes, xp and the period for oscillators or xq and the period for
+ *        spaceships, then an encoding of the cells of the phase and orientation with the smallest encoding.
+ *        Each row is written as hex digits, 4 cells per digit with the leftmost cell as the lowest bit, and
+ *        the rows are joined by z. So a block is xs4_3z3 and a blinker is xp2_7.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "soup_search.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "grid_view.h"
+#include "kernel.h"
+#include "thread_pool.h"
+
+namespace {
+    //Dead cells put around a soup at the start, and added to every side each time the field grows
+    constexpr std::size_t margin = 32;
+
+    //How close to the edge of the field a live cell can get before something has to be done about it
+    constexpr std::size_t edge = 4;
+
+    //The largest a field can grow before its soup is given up on as unstable
+    constexpr std::size_t max_field = 1024;
+
+    constexpr std::size_t max_generations = 20000;
+
+    //How often, in generations, spaceships heading away are looked for, and the population history checked
+    constexpr std::size_t escape_every = 128;
+    constexpr std::size_t check_every = 32;
+    constexpr std::size_t window = 2 * SoupSearch::max_period;
+
+    std::uint64_t mix(std::uint64_t z) {
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    //A half open bounding box, empty when x0 >= x1
+    struct Box {
+        std::size_t x0, y0, x1, y1;
+
+        bool empty() const {
+            return x0 >= x1 || y0 >= y1;
+        }
+    };
+
+    Box merge(const Box& a, const Box& b) {
+        if (a.empty()) {
+            return b;
+        }
+        if (b.empty()) {
+            return a;
+        }
+        return Box{std::min(a.x0, b.x0), std::min(a.y0, b.y0), std::max(a.x1, b.x1), std::max(a.y1, b.y1)};
+    }
+
+    //The cells of a grid within the bounding box of its live cells, and where that box was
+    struct Shape {
+        std::size_t x, y;
+        Grid cells;
+
+        bool same_cells(const Shape& other) const {
+            if (cells.get_width() != other.cells.get_width() || cells.get_height() != other.cells.get_height()) {
+                return false;
+            }
+            for (std::size_t i = 0; i < cells.get_height(); i++) {
+                if (!std::equal(cells.row(i, Grid::unchecked), cells.row(i, Grid::unchecked) + cells.get_width(),
+                                other.cells.row(i, Grid::unchecked))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    Shape extract(const Grid& grid) {
+        Box box{grid.get_width(), grid.get_height(), 0, 0};
+        for (std::size_t y = 0; y < grid.get_height(); y++) {
+            const Cell *row = grid.row(y, Grid::unchecked);
+            const Cell *first = std::find(row, row + grid.get_width(), Cell::ALIVE);
+            if (first == row + grid.get_width()) {
+                continue;
+            }
+            const std::size_t last = grid.get_width() - (std::find(std::make_reverse_iterator(row + grid.get_width()),
+                    std::make_reverse_iterator(row), Cell::ALIVE) - std::make_reverse_iterator(row + grid.get_width()));
+            box = merge(box, Box{static_cast<std::size_t>(first - row), y, last, y + 1});
+        }
+        if (box.empty()) {
+            return Shape{0, 0, Grid()};
+        }
+        return Shape{box.x0, box.y0, grid.crop(box.x0, box.y0, box.x1, box.y1)};
+    }
+
+    //Rows as hex digits joined by z, see the top of the file
+    std::string encode(const Grid& cells) {
+        static const char digits[] = "0123456789abcdef";
+        std::string code;
+        for (std::size_t y = 0; y < cells.get_height(); y++) {
+            if (y > 0) {
+                code += 'z';
+            }
+            const Cell *row = cells.row(y, Grid::unchecked);
+            for (std::size_t x = 0; x < cells.get_width(); x += 4) {
+                unsigned int digit = 0;
+                for (std::size_t bit = 0; bit < 4 && x + bit < cells.get_width(); bit++) {
+                    digit |= (row[x + bit] == Cell::ALIVE) ? (1u << bit) : 0u;
+                }
+                code += digits[digit];
+            }
+        }
+        return code;
+    }
+
+    //The smallest encoding of the cells under the 4 rotations and their mirror images
+    std::string canonical(const Grid& cells) {
+        Grid mirrored(cells.get_width(), cells.get_height());
+        for (std::size_t y = 0; y < cells.get_height(); y++) {
+            std::reverse_copy(cells.row(y, Grid::unchecked), cells.row(y, Grid::unchecked) + cells.get_width(),
+                              mirrored.row(y, Grid::unchecked));
+        }
+
+        std::string best;
+        for (const Grid *grid : {&cells, const_cast<const Grid*>(&mirrored)}) {
+            for (int rotation = 0; rotation < 4; rotation++) {
+                const std::string code = encode(grid->rotate(rotation));
+                if (best.empty() || code.size() < best.size() || (code.size() == best.size() && code < best)) {
+                    best = code;
+                }
+            }
+        }
+        return best;
+    }
+
+    //Steps a whole grid, treating everything outside it as dead
+    void step_grid(const Grid& in, Grid &out) {
+        const std::size_t height = in.get_height();
+        for (std::size_t y = 0; y < height; y++) {
+            Kernel::step_row((y > 0) ? in.row(y - 1, Grid::unchecked) : nullptr, in.row(y, Grid::unchecked),
+                             (y + 1 < height) ? in.row(y + 1, Grid::unchecked) : nullptr, out.row(y, Grid::unchecked),
+                             in.get_width(), false);
+        }
+    }
+
+    /**
+     * The square a soup evolves in. Only the bounding box of the live cells, and the box from the generation
+     * before, is stepped. Outside the current box, current is all dead. Outside the previous box, next is too.
+     */
+    struct Field {
+        Grid current;
+        Grid next;
+        Box alive{0, 0, 0, 0};
+        Box previous{0, 0, 0, 0};
+        std::size_t population = 0;
+
+        std::size_t width() const {
+            return current.get_width();
+        }
+
+        std::size_t height() const {
+            return current.get_height();
+        }
+
+        void reset(const std::size_t size) {
+            if (width() != size || height() != size) {
+                current = Grid(size, size);
+                next = Grid(size, size);
+            } else {
+                for (std::size_t y = 0; y < size; y++) {
+                    std::fill(current.row(y, Grid::unchecked), current.row(y, Grid::unchecked) + size, Cell::DEAD);
+                    std::fill(next.row(y, Grid::unchecked), next.row(y, Grid::unchecked) + size, Cell::DEAD);
+                }
+            }
+            alive = previous = Box{0, 0, 0, 0};
+            population = 0;
+        }
+
+        //Recounts the live cells of current within region, which must hold all of them
+        void rescan(const Box region) {
+            alive = Box{0, 0, 0, 0};
+            population = 0;
+            for (std::size_t y = region.y0; y < region.y1; y++) {
+                //Searches and counts that the compiler can vectorise, rather than a branch per cell
+                const Cell *begin = current.row(y, Grid::unchecked) + region.x0;
+                const Cell *end = begin + (region.x1 - region.x0);
+                const Cell *first = std::find(begin, end, Cell::ALIVE);
+                if (first == end) {
+                    continue;
+                }
+                const Cell *last = std::find(std::make_reverse_iterator(end), std::make_reverse_iterator(first),
+                                             Cell::ALIVE).base();
+                population += static_cast<std::size_t>(std::count(first, last, Cell::ALIVE));
+                alive = merge(alive, Box{region.x0 + static_cast<std::size_t>(first - begin), y,
+                                         region.x0 + static_cast<std::size_t>(last - begin), y + 1});
+            }
+        }
+
+        bool near_edge(const std::size_t distance) const {
+            return !alive.empty() && (alive.x0 < distance || alive.y0 < distance ||
+                                      alive.x1 + distance > width() || alive.y1 + distance > height());
+        }
+
+        void step() {
+            if (population == 0) {
+                return;
+            }
+            const Box grown{alive.x0 > 0 ? alive.x0 - 1 : 0, alive.y0 > 0 ? alive.y0 - 1 : 0,
+                            std::min(alive.x1 + 1, width()), std::min(alive.y1 + 1, height())};
+            const Box region = merge(grown, previous);
+            const std::size_t span = region.x1 - region.x0;
+            for (std::size_t y = region.y0; y < region.y1; y++) {
+                Kernel::step_row((y > 0) ? current.row(y - 1, Grid::unchecked) + region.x0 : nullptr,
+                                 current.row(y, Grid::unchecked) + region.x0,
+                                 (y + 1 < height()) ? current.row(y + 1, Grid::unchecked) + region.x0 : nullptr,
+                                 next.row(y, Grid::unchecked) + region.x0, span, false);
+            }
+            std::swap(current, next);
+            previous = alive;
+            rescan(region);
+        }
+
+        void grow() {
+            current.grow(margin, margin, margin, margin);
+            next = Grid(width(), height());
+            alive = Box{alive.x0 + margin, alive.y0 + margin, alive.x1 + margin, alive.y1 + margin};
+            previous = Box{0, 0, 0, 0};
+        }
+    };
+
+    /**
+     * Finds the groups of cells for which is_set is true within region, calling found with the cells of each.
+     * Cells within 2 of each other share a neighbour, so can affect each other, and are put in the same group.
+     * Visited cells are marked in stamps with a value unique to the call, so the buffer never needs clearing.
+     */
+    template <typename IsSet, typename Found>
+    void components(const std::size_t width, const std::size_t height, const Box& region,
+                    std::vector<std::uint32_t> &stamps, std::uint32_t &stamp, IsSet is_set, Found found) {
+        if (stamps.size() != width * height) {
+            stamps.assign(width * height, 0);
+            stamp = 0;
+        }
+        const std::uint32_t mark = ++stamp;
+
+        std::vector<std::pair<std::size_t, std::size_t>> cells;
+        std::vector<std::pair<std::size_t, std::size_t>> stack;
+        for (std::size_t y = region.y0; y < region.y1; y++) {
+            for (std::size_t x = region.x0; x < region.x1; x++) {
+                if (stamps[y * width + x] == mark || !is_set(x, y)) {
+                    continue;
+                }
+                cells.clear();
+                stamps[y * width + x] = mark;
+                stack.emplace_back(x, y);
+                while (!stack.empty()) {
+                    const auto [cx, cy] = stack.back();
+                    stack.pop_back();
+                    cells.emplace_back(cx, cy);
+                    for (std::size_t ny = (cy > 1 ? cy - 2 : 0); ny <= std::min(cy + 2, height - 1); ny++) {
+                        for (std::size_t nx = (cx > 1 ? cx - 2 : 0); nx <= std::min(cx + 2, width - 1); nx++) {
+                            if (stamps[ny * width + nx] != mark && is_set(nx, ny)) {
+                                stamps[ny * width + nx] = mark;
+                                stack.emplace_back(nx, ny);
+                            }
+                        }
+                    }
+                }
+                found(cells);
+            }
+        }
+    }
+
+    //Copies the given cells of a grid into a grid the size of their bounding box
+    Grid cut(const std::vector<std::pair<std::size_t, std::size_t>> &cells) {
+        Box box{cells.front().first, cells.front().second, cells.front().first + 1, cells.front().second + 1};
+        for (const auto& [x, y] : cells) {
+            box = merge(box, Box{x, y, x + 1, y + 1});
+        }
+        Grid object(box.x1 - box.x0, box.y1 - box.y0);
+        for (const auto& [x, y] : cells) {
+            object.set(x - box.x0, y - box.y0, Cell::ALIVE, Grid::unchecked);
+        }
+        return object;
+    }
+
+    //What stepping an object on its own shows, and its phases up to the one that repeats
+    struct Evolution {
+        SoupSearch::Kind kind = SoupSearch::Kind::Unknown;
+        std::size_t period = 0;
+        long long dx = 0;
+        long long dy = 0;
+        std::vector<Shape> phases;
+    };
+
+    //Steps an object for up to max_period generations, looking for the first to repeat its starting shape
+    Evolution evolve(const Grid& object) {
+        //Room for the object to move at the speed of light for the whole time it is stepped
+        const std::size_t pad = SoupSearch::max_period / 2 + 2;
+        Grid current(object.get_width() + 2 * pad, object.get_height() + 2 * pad);
+        Grid next(current.get_width(), current.get_height());
+        current.merge(object.view(), pad, pad, true);
+
+        Evolution evolution;
+        Shape start = extract(current);
+        if (start.cells.get_width() == 0) {
+            return evolution;
+        }
+        evolution.phases.push_back(std::move(start));
+
+        for (std::size_t generation = 1; generation <= SoupSearch::max_period; generation++) {
+            step_grid(current, next);
+            std::swap(current, next);
+            Shape shape = extract(current);
+            if (shape.cells.get_width() == 0) {
+                break;
+            }
+            const Shape &first = evolution.phases.front();
+            if (shape.same_cells(first)) {
+                evolution.period = generation;
+                evolution.dx = static_cast<long long>(shape.x) - static_cast<long long>(first.x);
+                evolution.dy = static_cast<long long>(shape.y) - static_cast<long long>(first.y);
+                evolution.kind = (evolution.dx != 0 || evolution.dy != 0) ? SoupSearch::Kind::Spaceship :
+                                 (generation == 1) ? SoupSearch::Kind::StillLife : SoupSearch::Kind::Oscillator;
+                break;
+            }
+            evolution.phases.push_back(std::move(shape));
+        }
+        return evolution;
+    }
+
+    //The smallest period the end of the population history repeats with, or 0 if it does not
+    std::size_t population_period(const std::vector<std::size_t> &history) {
+        const std::size_t n = history.size();
+        for (std::size_t period = 1; period <= SoupSearch::max_period; period++) {
+            if (n < window + period) {
+                return 0;
+            }
+            bool periodic = true;
+            for (std::size_t i = 0; i < window && periodic; i++) {
+                periodic = history[n - 1 - i] == history[n - 1 - i - period];
+            }
+            if (periodic) {
+                return period;
+            }
+        }
+        return 0;
+    }
+}
+
+/**
+ * SoupSearch::Object::describe()
+ *
+ * @return
+ *      A description such as "still life", "period 2 oscillator" or "c/4 diagonal spaceship".
+ */
+std::string SoupSearch::Object::describe() const {
+    switch (kind) {
+        case Kind::StillLife:
+            return "still life";
+        case Kind::Oscillator:
+            return "period " + std::to_string(period) + " oscillator";
+        case Kind::Spaceship: {
+            //Speed as a fraction of c in its lowest terms, then which way it goes
+            const long long distance = std::max(std::llabs(dx), std::llabs(dy));
+            const long long divisor = std::gcd(distance, static_cast<long long>(period));
+            const long long numerator = distance / divisor;
+            const long long denominator = static_cast<long long>(period) / divisor;
+            std::string speed = (numerator == 1) ? "c" : std::to_string(numerator) + "c";
+            if (denominator != 1) {
+                speed += "/" + std::to_string(denominator);
+            }
+            const char *direction = (dx == 0 || dy == 0) ? " orthogonal" :
+                                    (std::llabs(dx) == std::llabs(dy)) ? " diagonal" : " oblique";
+            return speed + direction + " spaceship";
+        }
+        default:
+            return "unclassified object";
+    }
+}
+
+/**
+ * SoupSearch::Census::add(object, count = 1)
+ *
+ * Count an object found in the ash.
+ */
+void SoupSearch::Census::add(const Object& object, const std::uint64_t count) {
+    auto found = objects.find(object.code);
+    if (found == objects.end()) {
+        objects.emplace(object.code, Tally{object, count});
+    } else {
+        found->second.count += count;
+    }
+}
+
+/**
+ * SoupSearch::Census::add(other)
+ *
+ * Add everything counted by another census, such as one kept by another thread.
+ */
+void SoupSearch::Census::add(const Census& other) {
+    for (const auto& entry : other.objects) {
+        add(entry.second.object, entry.second.count);
+    }
+    soups += other.soups;
+    unstable += other.unstable;
+}
+
+/**
+ * SoupSearch::Census::soups_per_second_per_core()
+ *
+ * @return
+ *      The throughput of the search that made the census, the figure to compare searches by.
+ */
+double SoupSearch::Census::soups_per_second_per_core() const {
+    return (seconds > 0.0 && threads > 0) ? static_cast<double>(soups) / seconds / threads : 0.0;
+}
+
+/**
+ * SoupSearch::SoupSearch(seed, soup_size = 16, threads = 0)
+ *
+ * Construct a search.
+ *
+ * @example
+ *
+ *      // Run a million 16x16 soups on every core and print what they left behind
+ *      SoupSearch search(42);
+ *      SoupSearch::print(std::cout, search.run(1000000));
+ *
+ * @param seed
+ *      Picks the soups, the same seed always gives the same soups.
+ *
+ * @param soup_size
+ *      Optional parameter. The width and height of each soup. Defaults to 16.
+ *
+ * @param threads
+ *      Optional parameter. The number of threads to search on, 0 for one per hardware thread. Defaults to 0.
+ */
+SoupSearch::SoupSearch(const std::uint64_t seed, const std::size_t soup_size, const unsigned int threads)
+    : seed(seed), soup_size(soup_size), threads(threads) {
+}
+
+/**
+ * SoupSearch::random(seed, soup, word)
+ *
+ * A counter based generator: the result is a hash of its arguments, so any word of any soup can be made
+ * directly, on any thread, without stepping a generator through the words before it.
+ *
+ * @return
+ *      64 random bits.
+ */
+std::uint64_t SoupSearch::random(const std::uint64_t seed, const std::uint64_t soup, const std::uint64_t word) {
+    return mix(mix(seed ^ mix(soup)) + word * 0xD1B54A32D192ED03ULL);
+}
+
+/**
+ * SoupSearch::fill(grid, x0, y0, size, seed, index)
+ *
+ * Fill a square of a grid with a soup, each cell alive with probability one half. Every row starts a new
+ * 64 bit word, so the soup does not depend on the size of the grid it is put in.
+ *
+ * @param grid
+ *      The grid to fill.
+ *
+ * @param x0, y0
+ *      The top left of the square.
+ *
+ * @param size
+ *      The width and height of the square.
+ *
+ * @param seed, index
+ *      The seed of the search and the number of the soup.
+ *
+ * @throws
+ *      std::out_of_range if the square does not fit in the grid.
+ */
+void SoupSearch::fill(Grid &grid, const std::size_t x0, const std::size_t y0, const std::size_t size,
+                      const std::uint64_t seed, const std::uint64_t index) {
+    if (x0 + size > grid.get_width() || y0 + size > grid.get_height()) {
+        throw std::out_of_range("Soup does not fit in the grid");
+    }
+    const std::size_t words_per_row = (size + 63) / 64;
+    for (std::size_t y = 0; y < size; y++) {
+        Cell *row = grid.row(y0 + y, Grid::unchecked) + x0;
+        for (std::size_t w = 0; w < words_per_row; w++) {
+            const std::uint64_t bits = random(seed, index, y * words_per_row + w);
+            const std::size_t count = std::min<std::size_t>(64, size - 64 * w);
+            for (std::size_t b = 0; b < count; b++) {
+                row[64 * w + b] = ((bits >> b) & 1) ? Cell::ALIVE : Cell::DEAD;
+            }
+        }
+    }
+}
+
+/**
+ * SoupSearch::classify(object)
+ *
+ * Step an object on its own for up to max_period generations to find out what it is.
+ *
+ * @param object
+ *      A grid holding just the object.
+ *
+ * @return
+ *      What the object is. Objects that die, or do not repeat within max_period generations, are Unknown.
+ */
+SoupSearch::Object SoupSearch::classify(const Grid& object) {
+    const Evolution evolution = evolve(object);
+    if (evolution.phases.empty()) {
+        return Object{"xx0_0", Kind::Unknown, 0, 0, 0, 0};
+    }
+    const std::size_t population = evolution.phases.front().cells.get_alive_cells();
+    Object result{"", evolution.kind, evolution.period, evolution.dx, evolution.dy, population};
+    const std::vector<Shape> &phases = evolution.phases;
+
+    //The canonical code is the same whichever phase and orientation the object was found in
+    std::string best;
+    const std::size_t phase_count = (result.kind == Kind::Unknown) ? 1 : phases.size();
+    for (std::size_t i = 0; i < phase_count; i++) {
+        const std::string code = canonical(phases[i].cells);
+        if (best.empty() || code.size() < best.size() || (code.size() == best.size() && code < best)) {
+            best = code;
+        }
+    }
+
+    switch (result.kind) {
+        case Kind::StillLife:
+            result.code = "xs" + std::to_string(population) + "_" + best;
+            break;
+        case Kind::Oscillator:
+            result.code = "xp" + std::to_string(result.period) + "_" + best;
+            break;
+        case Kind::Spaceship:
+            result.code = "xq" + std::to_string(result.period) + "_" + best;
+            break;
+        default:
+            result.code = "xx" + std::to_string(population) + "_" + best;
+    }
+    return result;
+}
+
+/**
+ * SoupSearch::search(index, census)
+ *
+ * Private helper that runs one soup to stabilisation and adds its ash to a census. See the top of the file.
+ *
+ * @param index
+ *      The number of the soup.
+ *
+ * @param census
+ *      The census of the thread running the soup.
+ */
+void SoupSearch::search(const std::uint64_t index, Census &census) const {
+    thread_local Field field;
+    thread_local std::vector<std::size_t> history;
+    thread_local std::vector<std::uint32_t> stamps;
+    thread_local std::uint32_t stamp = 0;
+    thread_local std::vector<char> seen;
+    thread_local std::vector<std::vector<std::pair<std::size_t, std::size_t>>> groups;
+    thread_local std::vector<Box> boxes;
+
+    census.soups++;
+    field.reset(soup_size + 2 * margin);
+    fill(field.current, margin, margin, soup_size, seed, index);
+    field.rescan(Box{margin, margin, margin + soup_size, margin + soup_size});
+    history.clear();
+
+    //Counts and removes spaceships that have got clear of everything else and are heading further away, since
+    //they can never meet anything again. Removing them early keeps the box that is stepped small
+    auto remove_escapees = [&]() {
+        groups.clear();
+        boxes.clear();
+        components(field.width(), field.height(), field.alive, stamps, stamp,
+                   [&](const std::size_t x, const std::size_t y) {
+                       return field.current.get(x, y, Grid::unchecked) == Cell::ALIVE;
+                   },
+                   [&](const std::vector<std::pair<std::size_t, std::size_t>> &cells) {
+                       Box box{cells.front().first, cells.front().second, cells.front().first, cells.front().second};
+                       for (const auto& [x, y] : cells) {
+                           box = Box{std::min(box.x0, x), std::min(box.y0, y), std::max(box.x1, x + 1),
+                                     std::max(box.y1, y + 1)};
+                       }
+                       groups.push_back(cells);
+                       boxes.push_back(box);
+                   });
+
+        //The box around every other group is the box around the groups before it and the groups after it
+        std::vector<Box> after(boxes.size() + 1, Box{0, 0, 0, 0});
+        for (std::size_t i = boxes.size(); i-- > 0;) {
+            after[i] = merge(boxes[i], after[i + 1]);
+        }
+        Box before{0, 0, 0, 0};
+        bool removed = false;
+        for (std::size_t i = 0; i < groups.size(); i++) {
+            const Box group = boxes[i];
+            const Box rest = merge(before, after[i + 1]);
+            before = merge(before, group);
+
+            //Only worth stepping if the group is already clear of the rest on some side
+            const bool left = rest.empty() || group.x1 + 2 <= rest.x0;
+            const bool right = rest.empty() || group.x0 >= rest.x1 + 2;
+            const bool up = rest.empty() || group.y1 + 2 <= rest.y0;
+            const bool down = rest.empty() || group.y0 >= rest.y1 + 2;
+            if (!left && !right && !up && !down) {
+                continue;
+            }
+            const Evolution evolution = evolve(cut(groups[i]));
+            if (evolution.kind != Kind::Spaceship || !((left && evolution.dx < 0) || (right && evolution.dx > 0) ||
+                                                      (up && evolution.dy < 0) || (down && evolution.dy > 0))) {
+                continue;
+            }
+            census.add(classify(cut(groups[i])));
+            for (const auto& [x, y] : groups[i]) {
+                field.current.set(x, y, Cell::DEAD, Grid::unchecked);
+            }
+            removed = true;
+        }
+        if (removed) {
+            field.rescan(field.alive);
+        }
+    };
+
+    //Makes sure nothing is within distance of the edge of the field, returns false if that needs too big a field
+    auto make_room = [&](const std::size_t distance) {
+        remove_escapees();
+        while (field.near_edge(distance)) {
+            if (field.width() + 2 * margin > max_field) {
+                return false;
+            }
+            field.grow();
+        }
+        return true;
+    };
+
+    for (std::size_t generation = 0; generation < max_generations; generation++) {
+        if (field.population == 0) {
+            return;
+        }
+        if (generation % escape_every == 0) {
+            remove_escapees();
+        }
+        if (field.near_edge(edge) && !make_room(edge)) {
+            break;
+        }
+        field.step();
+        history.push_back(field.population);
+
+        if (generation % check_every != 0) {
+            continue;
+        }
+        const std::size_t period = population_period(history);
+        if (period == 0) {
+            continue;
+        }
+
+        //Leave room for spaceships to travel while the phases are collected
+        const std::size_t reach = max_period / 2 + edge;
+        if (field.near_edge(reach) && !make_room(reach)) {
+            census.unstable++;
+            return;
+        }
+
+        //Mark every cell alive in any phase, so the phases of an oscillator are cut out together
+        const std::size_t phases = std::max<std::size_t>(period, 2);
+        const std::size_t width = field.width(), height = field.height();
+        seen.assign(width * height, 0);
+        Box region = field.alive;
+        for (std::size_t i = 0; i < phases; i++) {
+            //Stepping first means the phase left in current, which the objects are cut from, is marked too
+            field.step();
+            for (std::size_t y = field.alive.y0; y < field.alive.y1; y++) {
+                const Cell *row = field.current.row(y, Grid::unchecked);
+                for (std::size_t x = field.alive.x0; x < field.alive.x1; x++) {
+                    seen[y * width + x] |= (row[x] == Cell::ALIVE);
+                }
+            }
+            region = merge(region, field.alive);
+        }
+
+        components(width, height, region, stamps, stamp,
+                   [&](const std::size_t x, const std::size_t y) { return seen[y * width + x] != 0; },
+                   [&](const std::vector<std::pair<std::size_t, std::size_t>> &cells) {
+                       std::vector<std::pair<std::size_t, std::size_t>> alive;
+                       for (const auto& cell : cells) {
+                           if (field.current.get(cell.first, cell.second, Grid::unchecked) == Cell::ALIVE) {
+                               alive.push_back(cell);
+                           }
+                       }
+                       if (!alive.empty()) {
+                           census.add(classify(cut(alive)));
+                       }
+                   });
+        return;
+    }
+    census.unstable++;
+}
+
+/**
+ * SoupSearch::run(count, first = 0)
+ *
+ * Run a range of soups on a ThreadPool. Workers take soups in small blocks from a shared counter, so a few
+ * slow soups do not hold up the rest, and keep their own census until they run out of soups.
+ *
+ * @param count
+ *      How many soups to run.
+ *
+ * @param first
+ *      Optional parameter. The number of the first soup, so a search can be carried on where it left off.
+ *      Defaults to 0.
+ *
+ * @return
+ *      The census of every soup run, with the time taken and the number of threads used.
+ */
+SoupSearch::Census SoupSearch::run(const std::uint64_t count, const std::uint64_t first) const {
+    constexpr std::uint64_t block = 16;
+    const auto start = std::chrono::steady_clock::now();
+
+    ThreadPool pool(threads);
+    std::vector<Census> partial(pool.get_threads());
+    std::atomic<std::uint64_t> next(0);
+    for (Census &census : partial) {
+        pool.submit([this, &census, &next, count, first]() {
+            for (std::uint64_t begin = next.fetch_add(block); begin < count; begin = next.fetch_add(block)) {
+                const std::uint64_t end = std::min(begin + block, count);
+                for (std::uint64_t i = begin; i < end; i++) {
+                    search(first + i, census);
+                }
+            }
+        });
+    }
+    pool.wait_idle();
+
+    Census census;
+    for (const Census& part : partial) {
+        census.add(part);
+    }
+    census.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    census.threads = static_cast<unsigned int>(pool.get_threads());
+    return census;
+}
+
+/**
+ * SoupSearch::print(os, census)
+ *
+ * Print a census, one object per line with the most common first, followed by the throughput of the search.
+ *
+ * @param os
+ *      The stream to print to.
+ *
+ * @param census
+ *      The census to print.
+ */
+void SoupSearch::print(std::ostream &os, const Census& census) {
+    std::vector<const Tally*> tallies;
+    for (const auto& entry : census.objects) {
+        tallies.push_back(&entry.second);
+    }
+    std::stable_sort(tallies.begin(), tallies.end(), [](const Tally *a, const Tally *b) {
+        return a->count > b->count;
+    });
+
+    for (const Tally *tally : tallies) {
+        os << tally->count << '\t' << tally->object.code << '\t' << tally->object.describe() << '\n';
+    }
+    os << census.soups << " soups (" << census.unstable << " did not stabilise) in " << census.seconds
+       << " s on " << census.threads << " threads, " << census.soups_per_second_per_core()
+       << " soups per second per core" << std::endl;
+}
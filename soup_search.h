@@ -0,0 +1,87 @@
+/**
+ * Declares a search that runs random soups to stabilisation and takes a census of the objects left behind.
+ * Rich documentation for the api and behaviour the SoupSearch class can be found in soup_search.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include "grid.h"
+
+/**
+ * Declare the structure of the SoupSearch class, which spreads soups over a ThreadPool, each worker stepping
+ * its soups in thread_local buffers and keeping its own census until the search ends.
+ *
+ * Soup n of a search with a given seed is always the same soup, however many threads the search uses.
+ */
+class SoupSearch {
+public:
+    enum class Kind { StillLife, Oscillator, Spaceship, Unknown };
+
+    //An object found in the ash. dx and dy are how far a spaceship moves in one period
+    struct Object {
+        std::string code;
+        Kind kind;
+        std::size_t period;
+        long long dx;
+        long long dy;
+        std::size_t population;
+
+        //A description such as "period 2 oscillator" or "c/4 diagonal spaceship"
+        std::string describe() const;
+    };
+
+    struct Tally {
+        Object object;
+        std::uint64_t count;
+    };
+
+    //The objects found by a search keyed by their code, and how long it took
+    struct Census {
+        std::map<std::string, Tally> objects;
+        std::uint64_t soups = 0;
+        std::uint64_t unstable = 0;
+        double seconds = 0.0;
+        unsigned int threads = 0;
+
+        void add(const Object& object, std::uint64_t count = 1);
+        void add(const Census& other);
+        double soups_per_second_per_core() const;
+    };
+
+private:
+    std::uint64_t seed;
+    std::size_t soup_size;
+    unsigned int threads;
+
+    //Runs one soup and adds what it leaves behind to the census
+    void search(std::uint64_t index, Census &census) const;
+
+public:
+    //The longest period looked for, both when waiting for a soup to stabilise and when classifying its objects
+    static constexpr std::size_t max_period = 30;
+
+    //0 threads means one per hardware thread
+    explicit SoupSearch(std::uint64_t seed, std::size_t soup_size = 16, unsigned int threads = 0);
+
+    //64 random bits from a counter based generator, the same for the same arguments on any thread
+    static std::uint64_t random(std::uint64_t seed, std::uint64_t soup, std::uint64_t word);
+
+    //Fills a size x size square of the grid at x0, y0 with soup number index
+    static void fill(Grid &grid, std::size_t x0, std::size_t y0, std::size_t size, std::uint64_t seed,
+                     std::uint64_t index);
+
+    //Works out what a single isolated object is, and its code canonicalised over all 8 orientations and its phases
+    static Object classify(const Grid& object);
+
+    //Runs soups [first, first + count) and returns their census
+    Census run(std::uint64_t count, std::uint64_t first = 0) const;
+
+    //Prints a census, most common objects first, followed by the throughput
+    static void print(std::ostream &os, const Census& census);
+};
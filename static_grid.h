@@ -0,0 +1,473 @@
+/**
+ * Declares and implements a fixed size grid with inline storage that can be built, stepped and rotated at compile time,
+ * and a Lifeform class holding every phase and rotation of a small pattern, all worked out by the compiler.
+ *      - A StaticGrid<W, H> stores each row as the bits of one 64 bit integer, so W can be at most 64.
+ *      - Everything except converting to or stamping into a Grid is constexpr, so patterns can be constants.
+ *      - Stepping and rotating follow exactly the same conventions as World::step and Grid::rotate.
+ *      - Stamping a StaticGrid into a Grid allocates nothing and writes the alive cells straight into its rows.
+ *
+ * Templates have to be defined where they are declared, so unlike the rest of the project the documentation for
+ * these classes lives in this header.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "grid.h"
+
+/**
+ * Declare the structure of the StaticGrid class, a W x H grid of cells held as one bitmask per row.
+ *
+ * @example
+ *
+ *      // A glider, checked and built entirely at compile time
+ *      constexpr StaticGrid<3, 3> glider(" # "
+ *                                        "  #"
+ *                                        "###");
+ *      static_assert(glider.get_alive_cells() == 5, "a glider has five cells");
+ */
+template <std::size_t W, std::size_t H>
+class StaticGrid {
+    static_assert(W <= 64, "StaticGrid stores each row in 64 bits");
+
+private:
+    template <std::size_t, std::size_t> friend class StaticGrid;
+
+    //Bit x of rows[y] is set when the cell at x, y is alive, an extra element keeps 0 height grids legal
+    std::uint64_t rows[H + 1];
+
+public:
+    /**
+     * StaticGrid<W, H>::StaticGrid()
+     *
+     * Construct a grid with every cell dead.
+     */
+    constexpr StaticGrid() : rows{}{}
+
+    /**
+     * StaticGrid<W, H>::StaticGrid(picture)
+     *
+     * Construct a grid from a string of W * H characters in row major order, '#' for Cell::ALIVE and ' ' for
+     * Cell::DEAD. Adjacent string literals join together, so each row can be written on its own line.
+     *
+     * @param picture
+     *      The cells of the grid.
+     *
+     * @throws
+     *      std::logic_error if any character is not '#' or ' ', which is a compile error in a constant expression.
+     */
+    constexpr explicit StaticGrid(const char (&picture)[W * H + 1]) : rows{} {
+        for (std::size_t y = 0; y < H; y++){
+            for (std::size_t x = 0; x < W; x++){
+                const char value = picture[y * W + x];
+                if (value == '#'){
+                    rows[y] |= std::uint64_t(1) << x;
+                } else if (value != ' '){
+                    throw std::logic_error("A StaticGrid picture may only contain '#' and ' '");
+                }
+            }
+        }
+    }
+
+    //Getter methods that mirror those of the Grid class
+    static constexpr std::size_t get_width() {
+        return W;
+    }
+
+    static constexpr std::size_t get_height() {
+        return H;
+    }
+
+    static constexpr std::size_t get_total_cells() {
+        return W * H;
+    }
+
+    constexpr std::size_t get_alive_cells() const {
+        std::size_t alive_count = 0;
+        for (std::size_t y = 0; y < H; y++){
+            for (std::uint64_t bits = rows[y]; bits != 0; bits &= bits - 1){
+                alive_count++;
+            }
+        }
+        return alive_count;
+    }
+
+    constexpr std::size_t get_dead_cells() const {
+        return get_total_cells() - get_alive_cells();
+    }
+
+    /**
+     * StaticGrid<W, H>::get(x, y)
+     *
+     * @return
+     *      The value of the cell at x, y.
+     *
+     * @throws
+     *      std::out_of_range if x, y is not a valid coordinate within the grid.
+     */
+    constexpr Cell get(const std::size_t x, const std::size_t y) const {
+        if (x >= W || y >= H){
+            throw std::out_of_range("Incorrect values provided");
+        }
+        return ((rows[y] >> x) & 1) ? Cell::ALIVE : Cell::DEAD;
+    }
+
+    /**
+     * StaticGrid<W, H>::set(x, y, value)
+     *
+     * Set the value of the cell at x, y.
+     *
+     * @throws
+     *      std::out_of_range if x, y is not a valid coordinate within the grid.
+     */
+    constexpr void set(const std::size_t x, const std::size_t y, const Cell value) {
+        if (x >= W || y >= H){
+            throw std::out_of_range("Incorrect values provided");
+        }
+        if (value == Cell::ALIVE){
+            rows[y] |= std::uint64_t(1) << x;
+        } else {
+            rows[y] &= ~(std::uint64_t(1) << x);
+        }
+    }
+
+    /**
+     * StaticGrid<W, H>::row_bits(y)
+     *
+     * @return
+     *      Row y as a bitmask, bit x set when the cell at x, y is alive. Rows past the bottom are empty.
+     */
+    constexpr std::uint64_t row_bits(const std::size_t y) const {
+        return (y < H) ? rows[y] : 0;
+    }
+
+    /**
+     * StaticGrid<W, H>::step(toroidal = false)
+     *
+     * Work out the next generation with the same rules and edge handling as World::step.
+     *
+     * @param toroidal
+     *      Optional parameter. If true the edges wrap around, otherwise everything outside is dead.
+     *
+     * @return
+     *      The next generation.
+     */
+    constexpr StaticGrid step(const bool toroidal = false) const {
+        StaticGrid next;
+        for (std::size_t y = 0; y < H; y++){
+            for (std::size_t x = 0; x < W; x++){
+                unsigned int neighbours = 0;
+                for (int i = -1; i < 2; i++){
+                    for (int j = -1; j < 2; j++){
+                        if (i == 0 && j == 0){
+                            continue;
+                        }
+                        long long nx = static_cast<long long>(x) + j;
+                        long long ny = static_cast<long long>(y) + i;
+                        if (toroidal){
+                            nx = (nx + static_cast<long long>(W)) % static_cast<long long>(W);
+                            ny = (ny + static_cast<long long>(H)) % static_cast<long long>(H);
+                        } else if (nx < 0 || ny < 0 || nx >= static_cast<long long>(W) || ny >= static_cast<long long>(H)){
+                            continue;
+                        }
+                        neighbours += (rows[ny] >> nx) & 1;
+                    }
+                }
+
+                //Born with exactly three neighbours, survives with two or three
+                const bool alive = (rows[y] >> x) & 1;
+                if (neighbours == 3 || (neighbours == 2 && alive)){
+                    next.rows[y] |= std::uint64_t(1) << x;
+                }
+            }
+        }
+        return next;
+    }
+
+    /**
+     * StaticGrid<W, H>::rotate<Rotation>()
+     *
+     * Rotate by a multiple of 90 degrees following the same convention as Grid::rotate. The rotation is a
+     * template parameter because quarter turns swap the width and height, which are part of the type.
+     *
+     * @return
+     *      A StaticGrid<W, H> for even rotations or a StaticGrid<H, W> for odd ones.
+     */
+    template <int Rotation>
+    constexpr auto rotate() const {
+        constexpr int quarter_turns = ((Rotation % 4) + 4) % 4;
+        if constexpr (quarter_turns == 0){
+            return *this;
+        } else if constexpr (quarter_turns == 2){
+            StaticGrid rotated;
+            for (std::size_t y = 0; y < H; y++){
+                for (std::size_t x = 0; x < W; x++){
+                    if ((rows[y] >> x) & 1){
+                        rotated.rows[H - 1 - y] |= std::uint64_t(1) << (W - 1 - x);
+                    }
+                }
+            }
+            return rotated;
+        } else {
+            //A quarter turn clockwise moves x, y to H - 1 - y, x, three quarter turns move it to y, W - 1 - x
+            StaticGrid<H, W> rotated;
+            for (std::size_t y = 0; y < H; y++){
+                for (std::size_t x = 0; x < W; x++){
+                    if ((rows[y] >> x) & 1){
+                        if (quarter_turns == 1){
+                            rotated.rows[x] |= std::uint64_t(1) << (H - 1 - y);
+                        } else {
+                            rotated.rows[W - 1 - x] |= std::uint64_t(1) << y;
+                        }
+                    }
+                }
+            }
+            return rotated;
+        }
+    }
+
+    /**
+     * StaticGrid<W, H>::reflect()
+     *
+     * @return
+     *      The grid mirrored left to right, matching GridView::reflect.
+     */
+    constexpr StaticGrid reflect() const {
+        StaticGrid reflected;
+        for (std::size_t y = 0; y < H; y++){
+            for (std::size_t x = 0; x < W; x++){
+                if ((rows[y] >> x) & 1){
+                    reflected.rows[y] |= std::uint64_t(1) << (W - 1 - x);
+                }
+            }
+        }
+        return reflected;
+    }
+
+    /**
+     * StaticGrid<W, H>::embed<W2, H2>(x, y)
+     *
+     * Place this grid inside a larger empty grid with its top left corner at x, y.
+     *
+     * @return
+     *      The larger grid.
+     *
+     * @throws
+     *      std::out_of_range if this grid does not fit at x, y.
+     */
+    template <std::size_t W2, std::size_t H2>
+    constexpr StaticGrid<W2, H2> embed(const std::size_t x, const std::size_t y) const {
+        if (x > W2 || W > W2 - x || y > H2 || H > H2 - y){
+            throw std::out_of_range("Embedded grid does not fit");
+        }
+        StaticGrid<W2, H2> larger;
+        for (std::size_t i = 0; i < H; i++){
+            larger.rows[y + i] = rows[i] << x;
+        }
+        return larger;
+    }
+
+    /**
+     * StaticGrid<W, H>::evolve()
+     *
+     * Work out the next generation of the pattern on an unbounded plane, then move it back to the top left
+     * of the box. Used to follow a spaceship through its phases without it flying out of its box.
+     *
+     * @return
+     *      The next generation, with its bounding box in the top left corner.
+     *
+     * @throws
+     *      std::logic_error if the next generation no longer fits in W x H.
+     */
+    constexpr StaticGrid evolve() const {
+        //Cells can only be born one cell outside the current box, so a one cell margin is always enough
+        const StaticGrid<W + 2, H + 2> next = embed<W + 2, H + 2>(1, 1).step(false);
+
+        //Find the bounding box of the next generation
+        std::size_t min_x = W + 2, min_y = H + 2, max_x = 0, max_y = 0;
+        for (std::size_t y = 0; y < H + 2; y++){
+            for (std::size_t x = 0; x < W + 2; x++){
+                if ((next.rows[y] >> x) & 1){
+                    min_x = (x < min_x) ? x : min_x;
+                    min_y = (y < min_y) ? y : min_y;
+                    max_x = (x > max_x) ? x : max_x;
+                    max_y = (y > max_y) ? y : max_y;
+                }
+            }
+        }
+
+        StaticGrid evolved;
+        if (min_x > max_x){
+            //Everything died
+            return evolved;
+        }
+        if (max_x - min_x + 1 > W || max_y - min_y + 1 > H){
+            throw std::logic_error("Pattern outgrew its box");
+        }
+        for (std::size_t y = min_y; y <= max_y; y++){
+            evolved.rows[y - min_y] = next.rows[y] >> min_x;
+        }
+        return evolved;
+    }
+
+    constexpr bool operator==(const StaticGrid& other) const {
+        for (std::size_t y = 0; y < H; y++){
+            if (rows[y] != other.rows[y]){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const StaticGrid& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * StaticGrid<W, H>::to_grid(resource = nullptr)
+     *
+     * Copy the cells into a new Grid.
+     *
+     * @param resource
+     *      Optional parameter. The memory resource to allocate the grid from, defaults to the default resource.
+     *
+     * @return
+     *      A new W x H grid.
+     */
+    Grid to_grid(std::pmr::memory_resource *resource = nullptr) const {
+        Grid grid(W, H, resource);
+        stamp(grid, 0, 0);
+        return grid;
+    }
+
+    /**
+     * StaticGrid<W, H>::stamp(grid, x0, y0, alive_only = true)
+     *
+     * Write the cells into a grid with the top left corner at x0, y0, in the same way as Grid::merge. Nothing is
+     * allocated and only the alive cells are visited when alive_only is true.
+     *
+     * @example
+     *
+     *      // Put a glider heading up and left into the corner of a world
+     *      Zoo::glider_pattern.get<2>().stamp(world_grid, 0, 0);
+     *
+     * @param grid
+     *      The grid to write into.
+     *
+     * @param x0
+     *      The x coordinate to put the left edge at.
+     *
+     * @param y0
+     *      The y coordinate to put the top edge at.
+     *
+     * @param alive_only
+     *      Optional parameter. If true only alive cells are written, otherwise dead cells overwrite too. Defaults to true.
+     *
+     * @throws
+     *      std::out_of_range if the pattern does not fit within the grid at x0, y0.
+     */
+    void stamp(Grid& grid, const std::size_t x0, const std::size_t y0, const bool alive_only = true) const {
+        if (x0 > grid.get_width() || W > grid.get_width() - x0 || y0 > grid.get_height() || H > grid.get_height() - y0){
+            throw std::out_of_range("Stamped pattern does not fit within the grid");
+        }
+        for (std::size_t y = 0; y < H; y++){
+            Cell *cells = grid.row(y0 + y, Grid::unchecked) + x0;
+            if (alive_only){
+                //Walk the set bits only, lowest first
+                for (std::uint64_t bits = rows[y]; bits != 0; bits &= bits - 1){
+                    std::size_t x = 0;
+                    while (((bits >> x) & 1) == 0){
+                        x++;
+                    }
+                    cells[x] = Cell::ALIVE;
+                }
+            } else {
+                for (std::size_t x = 0; x < W; x++){
+                    cells[x] = ((rows[y] >> x) & 1) ? Cell::ALIVE : Cell::DEAD;
+                }
+            }
+        }
+    }
+};
+
+/**
+ * Declare the structure of the Lifeform class, every phase of a small pattern in all 4 rotations, all
+ * computed once by the compiler from a single seed.
+ *
+ * Each phase is the seed evolved that many generations on an unbounded plane and moved back to the top left of
+ * a W x H box, so spaceships stay in their box. Rotations are as Grid::rotate, odd rotations being H x W.
+ *
+ * @example
+ *
+ *      // Every phase and heading of a glider, with no work left to do at run time
+ *      constexpr Lifeform<3, 3, 4> glider(StaticGrid<3, 3>(" # "
+ *                                                          "  #"
+ *                                                          "###"));
+ *      glider.get<1>(2).stamp(grid, 10, 10);
+ */
+template <std::size_t W, std::size_t H, std::size_t Period>
+class Lifeform {
+    static_assert(Period >= 1, "A lifeform has at least one phase");
+
+private:
+    //Rotations 0 and 2 keep the box the same shape, rotations 1 and 3 turn it on its side
+    StaticGrid<W, H> upright[Period][2];
+    StaticGrid<H, W> sideways[Period][2];
+
+public:
+    /**
+     * Lifeform<W, H, Period>::Lifeform(seed)
+     *
+     * Work out every phase and rotation of a pattern.
+     *
+     * @param seed
+     *      The first phase in its first rotation.
+     *
+     * @throws
+     *      std::logic_error if Period is more than 1 and the pattern does not come back to the seed after Period
+     *      generations, or if it outgrows its box. Either is a compile error in a constant expression. A Period
+     *      of 1 is not checked, so a pattern that never repeats, like the r-pentomino, can still be catalogued.
+     */
+    constexpr explicit Lifeform(const StaticGrid<W, H>& seed) : upright{}, sideways{} {
+        StaticGrid<W, H> phase = seed;
+        for (std::size_t p = 0; p < Period; p++){
+            upright[p][0] = phase;
+            upright[p][1] = phase.template rotate<2>();
+            sideways[p][0] = phase.template rotate<1>();
+            sideways[p][1] = phase.template rotate<3>();
+            if (p + 1 < Period){
+                phase = phase.evolve();
+            }
+        }
+        if (Period > 1 && phase.evolve() != seed){
+            throw std::logic_error("Pattern does not repeat with the given period");
+        }
+    }
+
+    static constexpr std::size_t get_period() {
+        return Period;
+    }
+
+    /**
+     * Lifeform<W, H, Period>::get<Rotation>(phase = 0)
+     *
+     * @param phase
+     *      Optional parameter. The generation to get, wrapped round the period. Defaults to 0.
+     *
+     * @return
+     *      A read-only reference to the phase in the given rotation.
+     */
+    template <int Rotation>
+    constexpr const auto& get(const std::size_t phase = 0) const {
+        constexpr int quarter_turns = ((Rotation % 4) + 4) % 4;
+        if constexpr (quarter_turns % 2 == 0){
+            return upright[phase % Period][quarter_turns / 2];
+        } else {
+            return sideways[phase % Period][quarter_turns / 2];
+        }
+    }
+};
@@ -0,0 +1,546 @@
+/**
+ * Implements a class representing a 2d grid world that lives in a file on disk rather than in memory.
+ *      - Streaming worlds are stored in a block file:
+ *          - a 4 byte magic number "GOLS"
+ *          - an 8 byte std::size_t representing the grid width
+ *          - an 8 byte std::size_t representing the grid height
+ *          - followed by (width * height) cells, one byte each in C-style row/column format,
+ *            using the same ' ' and '#' characters as Cell::DEAD and Cell::ALIVE.
+ *
+ *      - Stepping reads from the block file and writes the next generation to a second file beside it,
+ *        which is then renamed over the original so a crash mid step never leaves a half written world.
+ *
+ *      - Only three bands of rows are held in memory at any time. While band i is being computed, band i+1
+ *        is prefetched on a background thread and band i-1 is written out on another, so the memory used
+ *        depends on the width and band size but never on the height of the world.
+ *
+ *      - Updating the world state can conditionally be performed using a toroidal topology.
+ *          - The first row and last row are cached before stepping so the first and last bands can wrap
+ *            around without seeking back through the file.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "streaming_world.h"
+#include "kernel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+
+namespace {
+    //The magic number at the start of every block file and the size of the whole header in bytes
+    const char magic[4] = {'G', 'O', 'L', 'S'};
+    const std::streamoff header_size = sizeof(magic) + 2 * sizeof(std::uint64_t);
+
+    //Converts a 2d coordinate to the byte offset of that cell within the block file
+    std::streamoff file_offset(std::size_t width, std::size_t x, std::size_t y) {
+        return header_size + static_cast<std::streamoff>(y) * width + x;
+    }
+
+    //Writes the header of a block file to an already opened stream
+    void write_header(std::ostream& os, std::size_t width, std::size_t height) {
+        std::uint64_t w = width;
+        std::uint64_t h = height;
+        os.write(magic, sizeof(magic));
+        os.write(reinterpret_cast<const char *>(&w), sizeof(w));
+        os.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    }
+}
+
+/**
+ * StreamingWorld::StreamingWorld(path, band_rows = 64)
+ *
+ * Open an existing block file as a streaming world. The file is not read into memory.
+ *
+ * @example
+ *
+ *      // Make a huge world on disk and open it
+ *      StreamingWorld::create("huge.gols", 100000, 100000);
+ *      StreamingWorld world("huge.gols");
+ *
+ * @param path
+ *      The std::string path to the block file.
+ *
+ * @param band_rows
+ *      Optional parameter. The number of rows read, computed and written at a time. Defaults to 64.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be opened or is not a block file,
+ *      or std::logic_error if band_rows is 0.
+ */
+StreamingWorld::StreamingWorld(const std::string& path, const std::size_t band_rows) : path(path),
+                                                                                        width(0),
+                                                                                        height(0),
+                                                                                        band_rows(band_rows) {
+    if (band_rows == 0){
+        throw std::logic_error("A streaming world needs at least one row per band");
+    }
+    read_header();
+}
+
+/**
+ * StreamingWorld::read_header()
+ *
+ * Private helper function to read the width and height from the header of the block file.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be opened or the header is not valid.
+ */
+void StreamingWorld::read_header() {
+    std::ifstream inFile(path, std::ios::in | std::ios::binary);
+    if (!inFile.is_open()){
+        throw std::runtime_error("File with that name could not be opened");
+    }
+
+    char file_magic[sizeof(magic)];
+    std::uint64_t w = 0;
+    std::uint64_t h = 0;
+    inFile.read(file_magic, sizeof(file_magic));
+    inFile.read(reinterpret_cast<char *>(&w), sizeof(w));
+    inFile.read(reinterpret_cast<char *>(&h), sizeof(h));
+    if (!inFile || !std::equal(magic, magic + sizeof(magic), file_magic)){
+        throw std::runtime_error("File is not a streaming world block file");
+    }
+
+    width = static_cast<std::size_t>(w);
+    height = static_cast<std::size_t>(h);
+}
+
+/**
+ * StreamingWorld::create(path, width, height)
+ *
+ * Write a new block file filled with dead cells, overwriting anything already at that path.
+ * The file is written a row at a time so worlds much larger than memory can be created.
+ *
+ * @example
+ *
+ *      // Make a 100000x100000 world on disk
+ *      StreamingWorld::create("huge.gols", 100000, 100000);
+ *
+ * @param path
+ *      The std::string path to the file to write to.
+ *
+ * @param width
+ *      The width of the world.
+ *
+ * @param height
+ *      The height of the world.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be written.
+ */
+void StreamingWorld::create(const std::string& path, const std::size_t width, const std::size_t height) {
+    std::ofstream outFile(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!outFile.is_open()){
+        throw std::runtime_error("File with that name could not be opened");
+    }
+
+    write_header(outFile, width, height);
+    std::vector<Cell> row(width, Cell::DEAD);
+    for (std::size_t i = 0; i < height; i++){
+        outFile.write(reinterpret_cast<const char *>(row.data()), width);
+    }
+
+    if (!outFile){
+        throw std::runtime_error("Could not write the streaming world to file");
+    }
+}
+
+/**
+ * StreamingWorld::create(path, initial_state)
+ *
+ * Write a new block file holding the contents of a grid, overwriting anything already at that path.
+ *
+ * @example
+ *
+ *      // Save a glider as a streaming world
+ *      StreamingWorld::create("glider.gols", Zoo::glider());
+ *
+ * @param path
+ *      The std::string path to the file to write to.
+ *
+ * @param initial_state
+ *      The grid to copy into the file.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be written.
+ */
+void StreamingWorld::create(const std::string& path, const Grid& initial_state) {
+    std::ofstream outFile(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!outFile.is_open()){
+        throw std::runtime_error("File with that name could not be opened");
+    }
+
+    write_header(outFile, initial_state.get_width(), initial_state.get_height());
+    std::vector<Cell> row(initial_state.get_width());
+    for (std::size_t i = 0; i < initial_state.get_height(); i++){
+        for (std::size_t j = 0; j < initial_state.get_width(); j++){
+            row[j] = initial_state.get(j, i);
+        }
+        outFile.write(reinterpret_cast<const char *>(row.data()), row.size());
+    }
+
+    if (!outFile){
+        throw std::runtime_error("Could not write the streaming world to file");
+    }
+}
+
+/**
+ * StreamingWorld::get_width()
+ *
+ * Gets the width of the world without reading the cells.
+ *
+ * @return
+ *      The width of the world.
+ */
+std::size_t StreamingWorld::get_width() const {
+    return width;
+}
+
+/**
+ * StreamingWorld::get_height()
+ *
+ * Gets the height of the world without reading the cells.
+ *
+ * @return
+ *      The height of the world.
+ */
+std::size_t StreamingWorld::get_height() const {
+    return height;
+}
+
+/**
+ * StreamingWorld::get_total_cells()
+ *
+ * Gets the total number of cells in the world.
+ *
+ * @return
+ *      The number of total cells.
+ */
+std::size_t StreamingWorld::get_total_cells() const {
+    return width * height;
+}
+
+/**
+ * StreamingWorld::get_alive_cells()
+ *
+ * Counts how many cells in the world are alive by streaming through the whole file one band at a time.
+ *
+ * @return
+ *      The number of alive cells.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if the file cannot be read.
+ */
+std::size_t StreamingWorld::get_alive_cells() const {
+    std::ifstream inFile(path, std::ios::in | std::ios::binary);
+    if (!inFile.is_open()){
+        throw std::runtime_error("File with that name could not be opened");
+    }
+    inFile.seekg(header_size);
+
+    std::size_t alive_count = 0;
+    std::vector<Cell> band(band_rows * width);
+    for (std::size_t first = 0; first < height; first += band_rows){
+        std::size_t count = std::min(band_rows, height - first) * width;
+        inFile.read(reinterpret_cast<char *>(band.data()), count);
+        if (!inFile){
+            throw std::runtime_error("Unexpected end to streaming world file, please check input");
+        }
+        alive_count += std::count(band.begin(), band.begin() + count, Cell::ALIVE);
+    }
+    return alive_count;
+}
+
+/**
+ * StreamingWorld::get_dead_cells()
+ *
+ * Counts how many cells in the world are dead.
+ *
+ * @return
+ *      The number of dead cells.
+ */
+std::size_t StreamingWorld::get_dead_cells() const {
+    return get_total_cells() - get_alive_cells();
+}
+
+/**
+ * StreamingWorld::get(x, y)
+ *
+ * Reads the value of a single cell straight from the file.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @return
+ *      The value of the desired cell.
+ *
+ * @throws
+ *      std::out_of_range if x,y is not a valid coordinate, or std::runtime_error if the file cannot be read.
+ */
+Cell StreamingWorld::get(const std::size_t x, const std::size_t y) const {
+    if (x >= width || y >= height){
+        throw std::out_of_range("Incorrect values provided");
+    }
+
+    std::ifstream inFile(path, std::ios::in | std::ios::binary);
+    inFile.seekg(file_offset(width, x, y));
+    char value = static_cast<char>(Cell::DEAD);
+    inFile.read(&value, 1);
+    if (!inFile){
+        throw std::runtime_error("Could not read from the streaming world file");
+    }
+    return static_cast<Cell>(value);
+}
+
+/**
+ * StreamingWorld::set(x, y, value)
+ *
+ * Overwrites a single cell straight in the file.
+ *
+ * @param x
+ *      The x coordinate of the cell to update.
+ *
+ * @param y
+ *      The y coordinate of the cell to update.
+ *
+ * @param value
+ *      The value to be written to the selected cell.
+ *
+ * @throws
+ *      std::out_of_range if x,y is not a valid coordinate, or std::runtime_error if the file cannot be written.
+ */
+void StreamingWorld::set(const std::size_t x, const std::size_t y, const Cell value) {
+    if (x >= width || y >= height){
+        throw std::out_of_range("Incorrect values provided");
+    }
+
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(file_offset(width, x, y));
+    char raw = static_cast<char>(value);
+    file.write(&raw, 1);
+    if (!file){
+        throw std::runtime_error("Could not write to the streaming world file");
+    }
+}
+
+/**
+ * StreamingWorld::load(x0, y0, x1, y1)
+ *
+ * Read a window of the world into memory as a grid, spanning the range [x0, x1) by [y0, y1).
+ *
+ * @example
+ *
+ *      // Look at the top left 80x24 corner of a huge world
+ *      std::cout << world.load(0, 0, 80, 24) << std::endl;
+ *
+ * @return
+ *      A new grid of the window size containing the values read from the file.
+ *
+ * @throws
+ *      std::out_of_range if the window is not within the world, std::logic_error if the window has a
+ *      negative size, or std::runtime_error if the file cannot be read.
+ */
+Grid StreamingWorld::load(const std::size_t x0, const std::size_t y0,
+                          const std::size_t x1, const std::size_t y1) const {
+    if ((x0 > x1) || (y0 > y1)){
+        throw std::logic_error("Window size is invalid");
+    }
+    if ((x1 > width) || (y1 > height)){
+        throw std::out_of_range("One of more values not in range");
+    }
+
+    std::ifstream inFile(path, std::ios::in | std::ios::binary);
+    Grid window(x1 - x0, y1 - y0);
+    std::vector<Cell> row(x1 - x0);
+    for (std::size_t i = y0; i < y1; i++){
+        inFile.seekg(file_offset(width, x0, i));
+        inFile.read(reinterpret_cast<char *>(row.data()), row.size());
+        if (!inFile){
+            throw std::runtime_error("Could not read from the streaming world file");
+        }
+        for (std::size_t j = 0; j < row.size(); j++){
+            window.set(j, i - y0, row[j]);
+        }
+    }
+    return window;
+}
+
+/**
+ * StreamingWorld::merge(other, x0, y0)
+ *
+ * Overwrite a window of the world with the contents of a grid, placing its top left corner at x0, y0.
+ *
+ * @example
+ *
+ *      // Drop a glider into a huge world
+ *      world.merge(Zoo::glider(), 5000, 5000);
+ *
+ * @throws
+ *      std::out_of_range if the grid does not fit within the world, or std::runtime_error if the file
+ *      cannot be written.
+ */
+void StreamingWorld::merge(const Grid& other, const std::size_t x0, const std::size_t y0) {
+    if ((x0 + other.get_width() > width) || (y0 + other.get_height() > height)){
+        throw std::out_of_range("The other grid does not fit within the bounds of the world");
+    }
+
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    std::vector<Cell> row(other.get_width());
+    for (std::size_t i = 0; i < other.get_height(); i++){
+        for (std::size_t j = 0; j < other.get_width(); j++){
+            row[j] = other.get(j, i);
+        }
+        file.seekp(file_offset(width, x0, y0 + i));
+        file.write(reinterpret_cast<const char *>(row.data()), row.size());
+    }
+    if (!file){
+        throw std::runtime_error("Could not write to the streaming world file");
+    }
+}
+
+/**
+ * StreamingWorld::step(toroidal)
+ *
+ * Take one step in Conway's Game of Life, streaming the world through memory a band of rows at a time.
+ *
+ * Three bands are in flight at once: band i+1 is being read, band i is being computed and band i-1 is
+ * being written. The next generation is written to path + ".next" and renamed over the original file
+ * once it is complete.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the step will consider the grid as a torus, where the left edge
+ *      wraps to the right edge and the top to the bottom. Defaults to false.
+ *
+ * @throws
+ *      Throws std::runtime_error or sub-class if either file cannot be read or written.
+ */
+void StreamingWorld::step(const bool toroidal) {
+    if (width == 0 || height == 0){
+        return;
+    }
+
+    const std::string next_path = path + ".next";
+    std::ifstream inFile(path, std::ios::in | std::ios::binary);
+    std::ofstream outFile(next_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!inFile.is_open() || !outFile.is_open()){
+        throw std::runtime_error("File with that name could not be opened");
+    }
+    write_header(outFile, width, height);
+
+    const std::size_t band_size = band_rows * width;
+    const std::size_t bands = (height + band_rows - 1) / band_rows;
+
+    //Reads count rows starting at first into a buffer, only ever called for one band at a time
+    auto read_band = [this, &inFile](std::vector<Cell>* buffer, std::size_t first, std::size_t count) {
+        inFile.seekg(file_offset(width, 0, first));
+        inFile.read(reinterpret_cast<char *>(buffer->data()), static_cast<std::streamsize>(count) * width);
+        if (!inFile){
+            throw std::runtime_error("Unexpected end to streaming world file, please check input");
+        }
+    };
+
+    //Writes count computed rows to the end of the next state file
+    auto write_band = [this, &outFile](const std::vector<Cell>* buffer, std::size_t count) {
+        outFile.write(reinterpret_cast<const char *>(buffer->data()), static_cast<std::streamsize>(count) * width);
+        if (!outFile){
+            throw std::runtime_error("Could not write the streaming world to file");
+        }
+    };
+
+    //The three bands of the window, plus two output buffers so one can be written while the other is filled
+    std::vector<Cell> current(band_size), next(band_size);
+    std::vector<Cell> output[2] = {std::vector<Cell>(band_size), std::vector<Cell>(band_size)};
+    std::vector<Cell> above(width);
+
+    //Cache the last row for the first band to wrap up to, and the first row for the last band to wrap down to
+    std::vector<Cell> first_row, last_row;
+    if (toroidal){
+        last_row.resize(width);
+        read_band(&last_row, height - 1, 1);
+    }
+
+    read_band(&current, 0, std::min(band_rows, height));
+    if (toroidal){
+        first_row.assign(current.begin(), current.begin() + width);
+    }
+
+    std::future<void> prefetch;
+    std::future<void> writer;
+    for (std::size_t band = 0; band < bands; band++){
+        const std::size_t first = band * band_rows;
+        const std::size_t count = std::min(band_rows, height - first);
+        const bool last_band = (band + 1 == bands);
+
+        //Start reading the next band while this one is computed
+        if (!last_band){
+            prefetch = std::async(std::launch::async, read_band, &next, first + band_rows,
+                                  std::min(band_rows, height - first - band_rows));
+        }
+
+        std::vector<Cell>& out = output[band % 2];
+        const Cell *row_above = (band == 0) ? (toroidal ? last_row.data() : nullptr) : above.data();
+
+        //Every row but the last only depends on this band and the row above it
+        for (std::size_t i = 0; i + 1 < count; i++){
+            const Cell *up = (i == 0) ? row_above : &current[(i - 1) * width];
+            Kernel::step_row(up, &current[i * width], &current[(i + 1) * width], &out[i * width], width, toroidal);
+        }
+
+        //The last row needs the first row of the next band, so wait for the prefetch to land
+        const Cell *row_below = toroidal ? first_row.data() : nullptr;
+        if (!last_band){
+            prefetch.get();
+            row_below = next.data();
+        }
+        const Cell *up = (count == 1) ? row_above : &current[(count - 2) * width];
+        Kernel::step_row(up, &current[(count - 1) * width], row_below, &out[(count - 1) * width], width, toroidal);
+
+        //Only one write is ever in flight, so the other output buffer is free for the next band
+        if (writer.valid()){
+            writer.get();
+        }
+        writer = std::async(std::launch::async, write_band, &out, count);
+
+        //Slide the window down, remembering the last row of this band for the first row of the next
+        std::copy(current.begin() + (count - 1) * width, current.begin() + count * width, above.begin());
+        current.swap(next);
+    }
+    writer.get();
+
+    inFile.close();
+    outFile.close();
+    if (!outFile){
+        throw std::runtime_error("Could not write the streaming world to file");
+    }
+
+    //Swap the next state into place in one go
+    if (std::rename(next_path.c_str(), path.c_str()) != 0){
+        throw std::runtime_error("Could not replace the streaming world file with its next state");
+    }
+}
+
+/**
+ * StreamingWorld::advance(steps, toroidal)
+ *
+ * Advance multiple steps in the Game of Life.
+ * Should be implemented by invoking StreamingWorld::step(toroidal).
+ *
+ * @param steps
+ *      The number of steps to advance the world forward.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the step will consider the grid as a torus, where the left edge
+ *      wraps to the right edge and the top to the bottom. Defaults to false.
+ */
+void StreamingWorld::advance(const std::size_t steps, const bool toroidal) {
+    for (std::size_t i = 0; i < steps; i++){
+        step(toroidal);
+    }
+}
@@ -0,0 +1,56 @@
+/**
+ * Declares a class representing a 2d grid world that lives in a file on disk rather than in memory.
+ * Rich documentation for the api and behaviour the StreamingWorld class can be found in streaming_world.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include "grid.h"
+
+/**
+ * Declare the structure of the StreamingWorld class for simulating worlds too large to fit in memory.
+ *
+ * The world is kept in a block file, only a sliding window of three bands of rows is ever held in memory.
+ */
+class StreamingWorld {
+private:
+    //The file holding the current state, the next state is written beside it and renamed into place
+    std::string path;
+    std::size_t width;
+    std::size_t height;
+
+    //How many rows are read, computed and written at a time
+    std::size_t band_rows;
+
+    //Reads the header of the block file at path, filling in the width and height
+    void read_header();
+
+public:
+    //Opens an existing block file, see StreamingWorld::create for making one
+    explicit StreamingWorld(const std::string& path, std::size_t band_rows = 64);
+
+    //Writes a new block file, either empty or holding the contents of a grid
+    static void create(const std::string& path, std::size_t width, std::size_t height);
+    static void create(const std::string& path, const Grid& initial_state);
+
+    //Getters that mirror those of the World class
+    std::size_t get_width() const;
+    std::size_t get_height() const;
+    std::size_t get_total_cells() const;
+    std::size_t get_alive_cells() const;
+    std::size_t get_dead_cells() const;
+
+    //Reads and writes single cells or whole windows of cells straight from and to the file
+    Cell get(std::size_t x, std::size_t y) const;
+    void set(std::size_t x, std::size_t y, Cell value);
+    Grid load(std::size_t x0, std::size_t y0, std::size_t x1, std::size_t y1) const;
+    void merge(const Grid& other, std::size_t x0, std::size_t y0);
+
+    //Steps the world on disk, one band of rows at a time
+    void step(bool toroidal = false);
+    void advance(std::size_t steps, bool toroidal = false);
+};
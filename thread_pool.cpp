@@ -0,0 +1,129 @@
+/**
+ * Implements a fixed pool of worker threads that run queued tasks.
+ *      - The threads are started once, when the pool is made, and wait on a condition variable between tasks,
+ *        so running a small task costs a queue push rather than starting a thread.
+ *      - Because a worker thread lives as long as the pool, thread_local buffers it fills for one task are
+ *        still there for the next.
+ *      - Exceptions thrown by a task are reported on std::cerr, the worker carries on with the next task.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "thread_pool.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+/**
+ * ThreadPool::ThreadPool(threads = 0)
+ *
+ * Construct a pool and start its worker threads.
+ *
+ * @example
+ *
+ *      // Step a batch of worlds on every core
+ *      ThreadPool pool;
+ *      for (World &world : worlds){
+ *          pool.submit([&world]() { world.advance(1000); });
+ *      }
+ *      pool.wait_idle();
+ *
+ * @param threads
+ *      Optional parameter. The number of worker threads, 0 for one per hardware thread. Defaults to 0.
+ */
+ThreadPool::ThreadPool(unsigned int threads) : running(0), stopping(false) {
+    if (threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threads);
+    for (unsigned int i = 0; i < threads; i++){
+        workers.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+/**
+ * ThreadPool::~ThreadPool()
+ *
+ * Finish every task already submitted, then stop the worker threads.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers){
+        worker.join();
+    }
+}
+
+/**
+ * ThreadPool::run()
+ *
+ * Private body of each worker thread. Takes tasks off the front of the queue and runs them without holding
+ * the lock, until the pool is stopping and the queue is empty.
+ */
+void ThreadPool::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return !tasks.empty() || stopping; });
+        if (tasks.empty()){
+            //Only reachable when stopping with nothing left to run
+            break;
+        }
+
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        running++;
+
+        lock.unlock();
+        try {
+            task();
+        } catch (const std::exception& ex) {
+            //There is nobody to throw to on this thread, so report it and move on
+            std::cerr << "Task failed: " << ex.what() << std::endl;
+        }
+        lock.lock();
+
+        running--;
+        if (tasks.empty() && running == 0){
+            idle.notify_all();
+        }
+    }
+}
+
+/**
+ * ThreadPool::get_threads()
+ *
+ * @return
+ *      The number of worker threads.
+ */
+std::size_t ThreadPool::get_threads() const {
+    return workers.size();
+}
+
+/**
+ * ThreadPool::submit(task)
+ *
+ * Queue a task to be run by the next free worker.
+ *
+ * @param task
+ *      The task to run.
+ */
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+/**
+ * ThreadPool::wait_idle()
+ *
+ * Block until the queue is empty and no task is running.
+ */
+void ThreadPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return tasks.empty() && running == 0; });
+}
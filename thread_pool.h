@@ -0,0 +1,53 @@
+/**
+ * Declares a fixed pool of worker threads that run queued tasks.
+ * Rich documentation for the api and behaviour the ThreadPool class can be found in thread_pool.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Declare the structure of the ThreadPool class, a set of threads started once and kept warm between tasks.
+ *
+ * Tasks are run in the order they are submitted, each on whichever worker is free first.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+
+    //The tasks waiting to run and how many are running, only touched while holding the mutex
+    std::deque<std::function<void()>> tasks;
+    std::size_t running;
+    bool stopping;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+
+    //The body of each worker thread
+    void run();
+
+public:
+    //0 threads means one per hardware thread
+    explicit ThreadPool(unsigned int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t get_threads() const;
+
+    //Queues a task to run on a worker
+    void submit(std::function<void()> task);
+
+    //Blocks until every task submitted so far has finished
+    void wait_idle();
+};
@@ -0,0 +1,452 @@
+/**
+ * Implements a class representing a 2d grid world split into tiles, where tiles that have settled into a still life
+ * or an oscillator are frozen and replayed instead of recomputed.
+ *      - The next state of a tile depends only on the tile and its apron, the ring of cells just outside it.
+ *      - Every generation the tile and apron of each active tile are hashed. When the hashes repeat with a period
+ *        p of at most max_period for two generations in a row, the next p generations are recorded into a ring of
+ *        phases. If the tile and apron then really are back where the recording started, the tile is frozen.
+ *        Hash collisions can only cause a wasted recording, never a wrong result.
+ *
+ *      - A frozen tile only has its apron compared against the stored phase each generation, then the next
+ *        phase is copied in. Period 1 and 2 tiles do not even need copying once both buffers hold their phases,
+ *        so a still life costs nothing but the apron check.
+ *      - As soon as the apron of a frozen tile differs from the stored phase, because something moving has
+ *        reached it, the tile is thawed and computed normally again.
+ *      - The results match World::step exactly, including how a toroidal topology wraps around.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#include "tile_world.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "kernel.h"
+
+namespace {
+    //A quick 64 bit hash of a block of cells, eight cells at a time
+    std::uint64_t hash_cells(const Cell *cells, const std::size_t count) {
+        std::uint64_t hash = 0x9E3779B97F4A7C15ull ^ count;
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8){
+            std::uint64_t word;
+            std::memcpy(&word, cells + i, sizeof(word));
+            hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 32;
+        }
+        for (; i < count; i++){
+            hash = (hash ^ static_cast<unsigned char>(cells[i])) * 0xC4CEB9FE1A85EC53ull;
+        }
+        return hash ^ (hash >> 29);
+    }
+
+    //Whether the outer ring of two width x height regions match
+    bool same_apron(const Cell *a, const Cell *b, const std::size_t width, const std::size_t height) {
+        if (std::memcmp(a, b, width) != 0 ||
+            std::memcmp(a + (height - 1) * width, b + (height - 1) * width, width) != 0){
+            return false;
+        }
+        for (std::size_t i = 1; i + 1 < height; i++){
+            if (a[i * width] != b[i * width] || a[i * width + width - 1] != b[i * width + width - 1]){
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * TileWorld::TileWorld(width, height, tile_size = 32, max_period = 15)
+ *
+ * Construct a world with every cell dead.
+ *
+ * @param width
+ *      The width of the world.
+ *
+ * @param height
+ *      The height of the world.
+ *
+ * @param tile_size
+ *      Optional parameter. The width and height of each tile. Defaults to 32.
+ *
+ * @param max_period
+ *      Optional parameter. The longest period of oscillation to look for. Defaults to 15, which covers pulsars.
+ *
+ * @throws
+ *      std::logic_error if tile_size or max_period is 0.
+ */
+TileWorld::TileWorld(const std::size_t width, const std::size_t height, const std::size_t tile_size,
+                     const unsigned int max_period) : TileWorld(Grid(width, height), tile_size, max_period){}
+
+/**
+ * TileWorld::TileWorld(initial_state, tile_size = 32, max_period = 15)
+ *
+ * Construct a world from an initial state, with every tile active.
+ *
+ * @example
+ *
+ *      // Run a soup until it is mostly ash, after which blinkers and pulsars cost next to nothing
+ *      TileWorld world(soup);
+ *      world.advance(100000, true);
+ *      std::cout << world.get_frozen_tiles() << " of " << world.get_tile_count() << " tiles frozen" << std::endl;
+ *
+ * @param initial_state
+ *      The state of the world to start from.
+ *
+ * @param tile_size
+ *      Optional parameter. The width and height of each tile. Defaults to 32.
+ *
+ * @param max_period
+ *      Optional parameter. The longest period of oscillation to look for. Defaults to 15, which covers pulsars.
+ *
+ * @throws
+ *      std::logic_error if tile_size or max_period is 0.
+ */
+TileWorld::TileWorld(const Grid& initial_state, const std::size_t tile_size, const unsigned int max_period) :
+        current_grid(initial_state),
+        next_grid(initial_state.get_width(), initial_state.get_height()),
+        tile_size(tile_size),
+        max_period(max_period),
+        tiles_x(0),
+        tiles_y(0),
+        generation(0),
+        toroidal(false) {
+    if (tile_size == 0 || max_period == 0){
+        throw std::logic_error("Tiles must be at least 1 cell and periods at least 1 generation");
+    }
+    region.resize((tile_size + 2) * (tile_size + 2));
+    out.resize(tile_size + 2);
+    reset_tiles();
+}
+
+/**
+ * TileWorld::reset_tiles()
+ *
+ * Private helper that splits the grid into tiles, the last row and column of tiles being smaller when the grid
+ * is not a multiple of the tile size, and makes every tile active.
+ */
+void TileWorld::reset_tiles() {
+    tiles_x = (current_grid.get_width() + tile_size - 1) / tile_size;
+    tiles_y = (current_grid.get_height() + tile_size - 1) / tile_size;
+    tiles.assign(tiles_x * tiles_y, Tile());
+    for (Tile &tile : tiles){
+        tile.hashes.assign(max_period + 2, 0);
+        thaw(tile);
+    }
+}
+
+/**
+ * TileWorld::thaw(tile)
+ *
+ * Private helper that makes a tile active again and forgets its history, so it has to repeat afresh before it
+ * can be frozen again.
+ */
+void TileWorld::thaw(Tile &tile) {
+    tile.mode = Mode::Active;
+    tile.period = 0;
+    tile.hash_count = 0;
+    tile.recorded = 0;
+    tile.frozen_at = 0;
+    tile.phases.clear();
+    tile.phases.shrink_to_fit();
+}
+
+/**
+ * TileWorld::gather(tx, ty, width, height, apron_only = false)
+ *
+ * Private helper that copies the tile and its apron out of the current grid into the region buffer, wrapping
+ * round the edges if toroidal or filling with Cell::DEAD otherwise, exactly as World::count_neighbours sees them.
+ *
+ * @param width
+ *      Set to the width of the tile, which is smaller than tile_size on the right edge.
+ *
+ * @param height
+ *      Set to the height of the tile, which is smaller than tile_size on the bottom edge.
+ *
+ * @param apron_only
+ *      Optional parameter. If true only the apron is copied and the interior of the region is left as it was,
+ *      which is all a frozen tile needs to check. Defaults to false.
+ */
+void TileWorld::gather(const std::size_t tx, const std::size_t ty, std::size_t &width, std::size_t &height,
+                       const bool apron_only) {
+    const std::size_t grid_width = current_grid.get_width();
+    const std::size_t grid_height = current_grid.get_height();
+    const std::size_t x0 = tx * tile_size;
+    const std::size_t y0 = ty * tile_size;
+    width = std::min(tile_size, grid_width - x0);
+    height = std::min(tile_size, grid_height - y0);
+
+    const std::size_t stride = width + 2;
+    for (std::size_t i = 0; i < height + 2; i++){
+        Cell *dst = &region[i * stride];
+
+        //Work out which row of the grid this is, if any
+        std::size_t y = y0 + i - 1;
+        bool outside = false;
+        if (i == 0 && y0 == 0){
+            outside = !toroidal;
+            y = grid_height - 1;
+        } else if (i == height + 1 && y0 + height == grid_height){
+            outside = !toroidal;
+            y = 0;
+        }
+        if (outside){
+            std::fill(dst, dst + stride, Cell::DEAD);
+            continue;
+        }
+
+        const Cell *src = current_grid.row(y, Grid::unchecked);
+        if (!apron_only || i == 0 || i == height + 1){
+            std::memcpy(dst + 1, src + x0, width * sizeof(Cell));
+        }
+        if (x0 != 0){
+            dst[0] = src[x0 - 1];
+        } else {
+            dst[0] = toroidal ? src[grid_width - 1] : Cell::DEAD;
+        }
+        if (x0 + width != grid_width){
+            dst[width + 1] = src[x0 + width];
+        } else {
+            dst[width + 1] = toroidal ? src[0] : Cell::DEAD;
+        }
+    }
+}
+
+/**
+ * TileWorld::compute(tx, ty, width, height)
+ *
+ * Private helper that steps the tile held in the region buffer into the next grid, a row at a time.
+ */
+void TileWorld::compute(const std::size_t tx, const std::size_t ty, const std::size_t width, const std::size_t height) {
+    const std::size_t stride = width + 2;
+    for (std::size_t i = 0; i < height; i++){
+        //The apron is part of the region, so the kernel never has to wrap
+        Kernel::step_row(&region[i * stride], &region[(i + 1) * stride], &region[(i + 2) * stride],
+                         out.data(), stride, false);
+        std::memcpy(next_grid.row(ty * tile_size + i, Grid::unchecked) + tx * tile_size, out.data() + 1,
+                    width * sizeof(Cell));
+    }
+}
+
+/**
+ * TileWorld::replay(tx, ty, width, height, phase)
+ *
+ * Private helper that copies the interior of a stored phase of the tile into the next grid.
+ */
+void TileWorld::replay(const std::size_t tx, const std::size_t ty, const std::size_t width, const std::size_t height,
+                       const Cell *phase) {
+    const std::size_t stride = width + 2;
+    for (std::size_t i = 0; i < height; i++){
+        std::memcpy(next_grid.row(ty * tile_size + i, Grid::unchecked) + tx * tile_size, phase + (i + 1) * stride + 1,
+                    width * sizeof(Cell));
+    }
+}
+
+/**
+ * TileWorld::get_width()
+ *
+ * @return
+ *      The width of the world.
+ */
+std::size_t TileWorld::get_width() const {
+    return current_grid.get_width();
+}
+
+/**
+ * TileWorld::get_height()
+ *
+ * @return
+ *      The height of the world.
+ */
+std::size_t TileWorld::get_height() const {
+    return current_grid.get_height();
+}
+
+/**
+ * TileWorld::get_total_cells()
+ *
+ * @return
+ *      The number of cells in the world.
+ */
+std::size_t TileWorld::get_total_cells() const {
+    return current_grid.get_total_cells();
+}
+
+/**
+ * TileWorld::get_alive_cells()
+ *
+ * @return
+ *      The number of alive cells in the current state.
+ */
+std::size_t TileWorld::get_alive_cells() const {
+    return current_grid.get_alive_cells();
+}
+
+/**
+ * TileWorld::get_dead_cells()
+ *
+ * @return
+ *      The number of dead cells in the current state.
+ */
+std::size_t TileWorld::get_dead_cells() const {
+    return current_grid.get_dead_cells();
+}
+
+/**
+ * TileWorld::get_state()
+ *
+ * @return
+ *      A read-only reference to the current state.
+ */
+const Grid& TileWorld::get_state() const {
+    return current_grid;
+}
+
+/**
+ * TileWorld::get_tile_count()
+ *
+ * @return
+ *      The number of tiles the world is split into.
+ */
+std::size_t TileWorld::get_tile_count() const {
+    return tiles.size();
+}
+
+/**
+ * TileWorld::get_frozen_tiles()
+ *
+ * @return
+ *      The number of tiles currently being replayed rather than computed.
+ */
+std::size_t TileWorld::get_frozen_tiles() const {
+    return std::count_if(tiles.begin(), tiles.end(), [](const Tile &tile) { return tile.mode == Mode::Frozen; });
+}
+
+/**
+ * TileWorld::set(x, y, value)
+ *
+ * Set a single cell and thaw the tile it is in. Frozen neighbours of that tile notice the change in their
+ * aprons on the next step by themselves.
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @param value
+ *      The new value of the cell.
+ *
+ * @throws
+ *      std::out_of_range if x, y is not a valid coordinate within the world.
+ */
+void TileWorld::set(const std::size_t x, const std::size_t y, const Cell value) {
+    current_grid.set(x, y, value);
+    thaw(tiles[(y / tile_size) * tiles_x + x / tile_size]);
+}
+
+/**
+ * TileWorld::step(toroidal = false)
+ *
+ * Take one step in Conway's Game of Life, giving exactly the same result as World::step.
+ *
+ * Frozen tiles gather only their apron, compare it with the stored phase and replay the next phase, or thaw if it
+ * differs. Every other tile is gathered with its apron once. Recording tiles store the phase, and freeze once the
+ * cycle closes. Active tiles are hashed and checked for a repeat. Every tile that is not frozen is then computed.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the step will consider the grid as a torus, where the left edge
+ *      wraps to the right edge and the top to the bottom. Changing the topology thaws every tile. Defaults to false.
+ */
+void TileWorld::step(const bool toroidal) {
+    if (toroidal != this->toroidal){
+        this->toroidal = toroidal;
+        reset_tiles();
+    }
+
+    const std::size_t ring = max_period + 2;
+    for (std::size_t ty = 0; ty < tiles_y; ty++){
+        for (std::size_t tx = 0; tx < tiles_x; tx++){
+            Tile &tile = tiles[ty * tiles_x + tx];
+            std::size_t width = 0, height = 0;
+
+            //The interior of a frozen tile is whatever its last replay wrote, so only the apron can have changed
+            if (tile.mode == Mode::Frozen){
+                gather(tx, ty, width, height, true);
+                const std::size_t region_size = (width + 2) * (height + 2);
+                const std::size_t phase = (generation - tile.frozen_at) % tile.period;
+                if (same_apron(region.data(), &tile.phases[phase * region_size], width + 2, height + 2)){
+                    //The next grid still holds the state from two generations ago, which for periods 1 and 2 is
+                    //already the phase wanted once both buffers have been written since freezing
+                    if (!((tile.period == 1 || tile.period == 2) && generation > tile.frozen_at)){
+                        const std::size_t next_phase = (phase + 1) % tile.period;
+                        replay(tx, ty, width, height, &tile.phases[next_phase * region_size]);
+                    }
+                    continue;
+                }
+
+                //Something from outside has reached the tile
+                thaw(tile);
+            }
+
+            gather(tx, ty, width, height);
+            const std::size_t region_size = (width + 2) * (height + 2);
+
+            if (tile.mode == Mode::Recording && tile.recorded == tile.period){
+                //A whole cycle has been recorded, it only counts if it really came back to the start
+                if (std::equal(region.begin(), region.begin() + region_size, tile.phases.begin())){
+                    tile.mode = Mode::Frozen;
+                    tile.frozen_at = generation;
+                    replay(tx, ty, width, height, &tile.phases[(1 % tile.period) * region_size]);
+                    continue;
+                }
+                thaw(tile);
+            }
+
+            if (tile.mode == Mode::Recording){
+                std::copy(region.begin(), region.begin() + region_size,
+                          tile.phases.begin() + tile.recorded * region_size);
+                tile.recorded++;
+            } else {
+                //Look for the shortest period that has repeated for the last two generations
+                const std::uint64_t hash = hash_cells(region.data(), region_size);
+                tile.hashes[generation % ring] = hash;
+                tile.hash_count++;
+                const std::uint64_t previous = tile.hashes[(generation + ring - 1) % ring];
+                for (unsigned int p = 1; p <= max_period && p + 2 <= tile.hash_count; p++){
+                    if (tile.hashes[(generation + ring - p) % ring] == hash &&
+                        tile.hashes[(generation + ring - p - 1) % ring] == previous){
+                        tile.mode = Mode::Recording;
+                        tile.period = p;
+                        tile.phases.assign(p * region_size, Cell::DEAD);
+                        std::copy(region.begin(), region.begin() + region_size, tile.phases.begin());
+                        tile.recorded = 1;
+                        break;
+                    }
+                }
+            }
+
+            compute(tx, ty, width, height);
+        }
+    }
+
+    std::swap(next_grid, current_grid);
+    generation++;
+}
+
+/**
+ * TileWorld::advance(steps, toroidal = false)
+ *
+ * Advance multiple steps in the Game of Life.
+ *
+ * @param steps
+ *      The number of steps to advance the world forward.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the steps will consider the grid as a torus. Defaults to false.
+ */
+void TileWorld::advance(const std::size_t steps, const bool toroidal) {
+    for (std::size_t i = 0; i < steps; i++){
+        step(toroidal);
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * Declares a class representing a 2d grid world split into tiles, where tiles that have settled into a still life
+ * or an oscillator are frozen and replayed instead of recomputed.
+ * Rich documentation for the api and behaviour the TileWorld class can be found in tile_world.cpp.
+ *
+ * @author 953238
+ * @date October, 2026
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "grid.h"
+
+/**
+ * Declare the structure of the TileWorld class, a World that skips the parts of the grid that are periodic.
+ *
+ * The grid is split into square tiles. Each tile is looked at together with its apron, the ring of cells just
+ * outside it, since that is everything the next state of the tile depends on. When the tile and apron repeat
+ * with a small period the tile is frozen and its states are replayed from a ring of stored phases, as long as
+ * its apron keeps following the same cycle. Still lifes are simply oscillators with a period of 1.
+ */
+class TileWorld {
+private:
+    //Active tiles are computed and watched for repeats, recording tiles are computed while their phases are
+    //captured, frozen tiles are replayed
+    enum class Mode : unsigned char {
+        Active,
+        Recording,
+        Frozen
+    };
+
+    struct Tile {
+        Mode mode;
+        unsigned int period;
+
+        //Hashes of the tile and apron for the most recent generations, indexed by generation
+        std::vector<std::uint64_t> hashes;
+        std::size_t hash_count;
+
+        //The tile and apron for each phase of the cycle, and the generation of phase 0
+        std::vector<Cell> phases;
+        std::size_t recorded;
+        std::uint64_t frozen_at;
+    };
+
+    Grid current_grid;
+    Grid next_grid;
+
+    std::size_t tile_size;
+    unsigned int max_period;
+    std::size_t tiles_x;
+    std::size_t tiles_y;
+    std::vector<Tile> tiles;
+
+    std::uint64_t generation;
+    bool toroidal;
+
+    //Scratch buffers reused by every tile
+    std::vector<Cell> region;
+    std::vector<Cell> out;
+
+    //Lays out the tiles for the current grid, all of them active
+    void reset_tiles();
+    void thaw(Tile &tile);
+
+    //Copies the tile at tx, ty and its apron, or just its apron, out of the current grid into region, returning
+    //its width and height
+    void gather(std::size_t tx, std::size_t ty, std::size_t &width, std::size_t &height, bool apron_only = false);
+
+    //Computes the next state of the tile at tx, ty from region into the next grid
+    void compute(std::size_t tx, std::size_t ty, std::size_t width, std::size_t height);
+
+    //Writes the interior of a stored phase into the next grid
+    void replay(std::size_t tx, std::size_t ty, std::size_t width, std::size_t height, const Cell *phase);
+
+public:
+    //Constructors that mirror those of the World class, with a choice of tile size and longest period to detect
+    TileWorld(std::size_t width, std::size_t height, std::size_t tile_size = 32, unsigned int max_period = 15);
+    explicit TileWorld(const Grid& initial_state, std::size_t tile_size = 32, unsigned int max_period = 15);
+
+    //Getters that mirror those of the World class
+    std::size_t get_width() const;
+    std::size_t get_height() const;
+    std::size_t get_total_cells() const;
+    std::size_t get_alive_cells() const;
+    std::size_t get_dead_cells() const;
+    const Grid& get_state() const;
+
+    //How the tiles are currently being handled
+    std::size_t get_tile_count() const;
+    std::size_t get_frozen_tiles() const;
+
+    //Changes a single cell, thawing its tile
+    void set(std::size_t x, std::size_t y, Cell value);
+
+    //Steps the world, replaying frozen tiles and computing the rest
+    void step(bool toroidal = false);
+    void advance(std::size_t steps, bool toroidal = false);
+};
@@ -22,6 +22,18 @@
  * @date March, 2020
  */
 #include "world.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include "edit_queue.h"
+#include "grid_memory.h"
+#include "kernel.h"
+#include "snapshot.h"
 
 /**
  * World::World()
@@ -34,7 +46,8 @@
  *      World world;
  *
  */
-World::World() : current_grid(Grid()), next_grid(current_grid){}
+World::World() : current_grid(Grid()), next_grid(current_grid), mode(StepMode::Bands), threads(0), step_cost(0.0),
+                 step_deviation(0.0), edits(nullptr), publisher(nullptr), generation(0){}
 
 /**
  * World::World(square_size)
@@ -55,8 +68,15 @@ World::World() : current_grid(Grid()), next_grid(current_grid){}
  * @param square_size
  *      The edge size to use for the width and height of the world.
  */
-World::World(const unsigned int square_size) : current_grid(Grid(square_size)),
-                                               next_grid(current_grid){}
+World::World(const std::size_t square_size) : current_grid(Grid(square_size)),
+                                               next_grid(current_grid),
+                                               mode(StepMode::Bands),
+                                               threads(0),
+                                               step_cost(0.0),
+                                               step_deviation(0.0),
+                                               edits(nullptr),
+                                               publisher(nullptr),
+                                               generation(0){}
 
 /**
  * World::World(width, height)
@@ -73,8 +93,15 @@ World::World(const unsigned int square_size) : current_grid(Grid(square_size)),
  * @param height
  *      The height of the world.
  */
-World::World(const unsigned int width, const unsigned int height) : current_grid(Grid(width, height)),
-                                                                    next_grid(current_grid){}
+World::World(const std::size_t width, const std::size_t height) : current_grid(Grid(width, height)),
+                                                                    next_grid(current_grid),
+                                                                    mode(StepMode::Bands),
+                                                                    threads(0),
+                                                                    step_cost(0.0),
+                                                                    step_deviation(0.0),
+                                                                    edits(nullptr),
+                                                                    publisher(nullptr),
+                                                                    generation(0){}
 
 
 /**
@@ -97,7 +124,14 @@ World::World(const unsigned int width, const unsigned int height) : current_grid
  *      The state of the constructed world.
  */
 World::World(const Grid& initial_state) : current_grid(initial_state),
-                                          next_grid(current_grid){}
+                                          next_grid(current_grid),
+                                          mode(StepMode::Bands),
+                                          threads(0),
+                                          step_cost(0.0),
+                                          step_deviation(0.0),
+                                          edits(nullptr),
+                                          publisher(nullptr),
+                                          generation(0){}
 
 /**
  * World::get_width()
@@ -122,7 +156,7 @@ World::World(const Grid& initial_state) : current_grid(initial_state),
  * @return
  *      The width of the world.
  */
-unsigned int World::get_width() const {
+std::size_t World::get_width() const {
     return current_grid.get_width();
 }
 
@@ -149,7 +183,7 @@ unsigned int World::get_width() const {
  * @return
  *      The height of the world.
  */
-unsigned int World::get_height() const {
+std::size_t World::get_height() const {
     return current_grid.get_height();
 }
 
@@ -176,7 +210,7 @@ unsigned int World::get_height() const {
  * @return
  *      The number of total cells.
  */
- unsigned int World::get_total_cells() const {
+ std::size_t World::get_total_cells() const {
      return current_grid.get_total_cells();
  }
 
@@ -204,7 +238,7 @@ unsigned int World::get_height() const {
  * @return
  *      The number of alive cells.
  */
-unsigned int World::get_alive_cells() const {
+std::size_t World::get_alive_cells() const {
     return current_grid.get_alive_cells();
 }
 
@@ -231,7 +265,7 @@ unsigned int World::get_alive_cells() const {
  * @return
  *      The number of dead cells.
  */
- unsigned int World::get_dead_cells() const {
+ std::size_t World::get_dead_cells() const {
      return current_grid.get_dead_cells();
  }
 
@@ -284,10 +318,9 @@ unsigned int World::get_alive_cells() const {
  * @param square_size
  *      The new edge size for both the width and height of the grid.
  */
- void World::resize(unsigned int new_square_size) {
+ void World::resize(std::size_t new_square_size) {
      //Resize both the current and next grid
-     current_grid.resize(new_square_size);
-     next_grid.resize(new_square_size);
+     resize(new_square_size, new_square_size);
  }
 
 
@@ -313,13 +346,44 @@ unsigned int World::get_alive_cells() const {
  * @param new_height
  *      The new height for the grid.
  */
- void World::resize(unsigned int new_width, unsigned int new_height) {
-     //Resize both the current and next grid, could perform a swap action here to possibly save processing time but
-     //this works
+ void World::resize(std::size_t new_width, std::size_t new_height) {
+     //Resize both the current and next grid, every cell of the next grid is overwritten by the next step
+     //so there is no need to pay for keeping its content
      current_grid.resize(new_width, new_height);
-     next_grid.resize(new_width, new_height);
+     next_grid.resize(new_width, new_height, false);
  }
 
+/**
+ * World::grow(left, top, right, bottom)
+ *
+ * Expand the world by a margin of dead cells on each side, keeping the current state in place relative to
+ * its neighbours. This lets a world expand around its contents as they spread.
+ *
+ * @example
+ *
+ *      // Make a world
+ *      World world(4, 4);
+ *
+ *      // Give it 10 cells of room to spread in every direction, making it 24x24
+ *      world.grow(10, 10, 10, 10);
+ *
+ * @param left
+ *      The number of columns to add to the left edge.
+ *
+ * @param top
+ *      The number of rows to add to the top edge.
+ *
+ * @param right
+ *      The number of columns to add to the right edge.
+ *
+ * @param bottom
+ *      The number of rows to add to the bottom edge.
+ */
+void World::grow(std::size_t left, std::size_t top, std::size_t right, std::size_t bottom) {
+    current_grid.grow(left, top, right, bottom);
+    next_grid.resize(current_grid.get_width(), current_grid.get_height(), false);
+}
+
 
 /**
  * World::count_neighbours(x, y, toroidal)
@@ -352,9 +416,9 @@ unsigned int World::get_alive_cells() const {
  * @return
  *      Returns the number of alive neighbours.
  */
- unsigned int World::count_neighbours(unsigned int x, unsigned int y, bool toroidal) {
+ std::size_t World::count_neighbours(std::size_t x, std::size_t y, bool toroidal) {
      //Count initially 0
-     unsigned int count = 0;
+     std::size_t count = 0;
      //For a given cell, consider all of the cells adjacent to it
      for (int i = -1; i < 2; i++){
          for (int j = -1; j < 2; j++){
@@ -363,31 +427,32 @@ unsigned int World::get_alive_cells() const {
                  if (toroidal){
                      //If the grid wraps around...
 
-                     //Had to add in int and unsigned int conversions to pipe down the wall warnings
-                     //It makes sense to have the width and height as unsigned ints as they can't be negative
-                     //Whereas new_x and new_y could be positive or negative so they have to be ints
+                     //Had to add in long long and std::size_t conversions to pipe down the wall warnings
+                     //It makes sense to have the width and height as std::size_ts as they can't be negative
+                     //Whereas new_x and new_y could be positive or negative so they have to be signed
 
                      //new_x and new_y are the coordinates of the neighbour being checked
-                     int new_x = (int) x+j;
-                     int new_y = (int) y+i;
+                     long long new_x = (long long) x+j;
+                     long long new_y = (long long) y+i;
 
                      //Checks if the neighbour is outside of the grid, if so, since toroidal, wrap around to the
                      //other side
                      if (new_x < 0){
-                         new_x = (int) current_grid.get_width() - 1;
-                     } else if ((unsigned) new_x > current_grid.get_width() - 1){
+                         new_x = (long long) current_grid.get_width() - 1;
+                     } else if ((std::size_t) new_x > current_grid.get_width() - 1){
                          new_x = 0;
                      }
 
                      //Do same for y as was done for x
                      if (new_y < 0){
-                         new_y = (int) current_grid.get_height() - 1;
-                     } else if ((unsigned int) new_y > current_grid.get_height() - 1){
+                         new_y = (long long) current_grid.get_height() - 1;
+                     } else if ((std::size_t) new_y > current_grid.get_height() - 1){
                          new_y = 0;
                      }
 
                      //If the neighbouring cell is alive, increment the count
-                     if (current_grid.get(new_x, new_y) == Cell::ALIVE){
+                     //The coordinate has just been wrapped into the grid so there is no need to check it again
+                     if (current_grid.get(new_x, new_y, Grid::unchecked) == Cell::ALIVE){
                          count += 1;
                      }
                  } else {
@@ -395,7 +460,7 @@ unsigned int World::get_alive_cells() const {
                      //As long as the adjacent cell if within the bounds of the grid...
                      if ((0 <= x+j) && (x+j < current_grid.get_width()) && ((0 <= y+i) && (y+i < current_grid.get_height()))){
                          //If that neighbour is alive, increment the count
-                         if (current_grid.get(x+j, y+i) == Cell::ALIVE){
+                         if (current_grid.get(x+j, y+i, Grid::unchecked) == Cell::ALIVE){
                              count += 1;
                          }
                      }
@@ -408,12 +473,307 @@ unsigned int World::get_alive_cells() const {
      return count;
  }
 
+/**
+ * World::set_edit_queue(queue)
+ *
+ * Connect a queue that other threads send edits through. Everything in the queue is applied to the current
+ * state just before each generation is computed, so edits never race with a step.
+ *
+ * @example
+ *
+ *      // Let an operator clear regions of a world while it runs
+ *      EditQueue edits;
+ *      world.set_edit_queue(&edits);
+ *      std::thread operator_thread([&edits]() {
+ *          EditQueue::Source source(edits, 0);
+ *          source.clear(0, 0, 100, 100);
+ *      });
+ *      world.advance(1000);
+ *
+ * @param queue
+ *      The queue to drain, which must outlive the world or be disconnected first, or nullptr to disconnect.
+ */
+void World::set_edit_queue(EditQueue *queue) {
+    edits = queue;
+}
+
+/**
+ * World::set_snapshot_publisher(publisher)
+ *
+ * Connect a publisher that each completed generation is copied to, so other threads can read generations
+ * through it while the world keeps stepping. get_state is only safe to use from the thread stepping the world.
+ *
+ * @example
+ *
+ *      // Let a metrics thread watch the population of a running world
+ *      SnapshotPublisher publisher;
+ *      world.set_snapshot_publisher(&publisher);
+ *      std::thread metrics([&publisher]() {
+ *          Snapshot snapshot = publisher.acquire();
+ *          if (snapshot){
+ *              std::cout << snapshot.get_state().get_alive_cells() << std::endl;
+ *          }
+ *      });
+ *      world.advance(1000);
+ *
+ * @param publisher
+ *      The publisher to use, which must outlive the world or be disconnected first, or nullptr to disconnect.
+ */
+void World::set_snapshot_publisher(SnapshotPublisher *publisher) {
+    this->publisher = publisher;
+}
+
+/**
+ * World::get_generation()
+ *
+ * @return
+ *      The number of generations the world has been stepped since it was made.
+ */
+std::uint64_t World::get_generation() const {
+    return generation;
+}
+
+/**
+ * World::finish_generations(steps)
+ *
+ * Private helper that counts the generations just completed and, if a publisher is connected, publishes the
+ * latest of them. Publishing never waits on readers, at worst the generation is skipped.
+ */
+void World::finish_generations(const std::size_t steps) {
+    generation += steps;
+    if (publisher != nullptr){
+        publisher->publish(current_grid, generation);
+    }
+}
+
+/**
+ * World::set_step_mode(mode)
+ *
+ * Choose how the world is stepped. Every mode gives exactly the same results, only how fast they arrive differs.
+ * Edits from a connected edit queue always go in between generations, and a connected snapshot publisher is
+ * given every generation, so while either is connected the Wavefront mode advances a generation at a time like
+ * the Bands mode.
+ *
+ * @example
+ *
+ *      // Step a 512x512 world several generations at a time across every core
+ *      World world(512, 512);
+ *      world.set_step_mode(StepMode::Wavefront);
+ *      world.advance(1000, true);
+ *
+ * @param mode
+ *      The mode to use from now on. Worlds start in StepMode::Bands.
+ */
+void World::set_step_mode(const StepMode mode) {
+    //The timings of one mode say nothing about another
+    if (mode != this->mode){
+        step_cost = 0.0;
+        step_deviation = 0.0;
+    }
+    this->mode = mode;
+}
+
+/**
+ * World::get_step_mode()
+ *
+ * @return
+ *      How the world is currently stepped.
+ */
+StepMode World::get_step_mode() const {
+    return mode;
+}
+
+/**
+ * World::set_threads(threads)
+ *
+ * Set how many threads the Bands and Wavefront modes step this world with, without changing the thread count
+ * shared by every other grid through GridMemory::set_threads.
+ *
+ * @example
+ *
+ *      // Step one world on 4 threads while everything else keeps using every core
+ *      World world(4096, 4096);
+ *      world.set_threads(4);
+ *      world.advance(100);
+ *
+ * @param threads
+ *      The number of threads, 0 for GridMemory::get_threads(). Worlds start with 0.
+ */
+void World::set_threads(const unsigned int threads) {
+    //The timings of one thread count say nothing about another
+    if (threads != this->threads){
+        step_cost = 0.0;
+        step_deviation = 0.0;
+    }
+    this->threads = threads;
+}
+
+/**
+ * World::get_threads()
+ *
+ * @return
+ *      How many threads the threaded modes step this world with, never 0.
+ */
+unsigned int World::get_threads() const {
+    return (threads != 0) ? threads : GridMemory::get_threads();
+}
+
+/**
+ * World::step_bands(toroidal)
+ *
+ * Private helper that takes one step with the row kernel, the rows split into one band per thread by
+ * GridMemory::for_each_band. That is the same split grids are first touched with, so each thread steps rows in
+ * its own memory. Grids too small to be worth splitting are stepped on the calling thread.
+ *
+ * @param toroidal
+ *      If true then the step will consider the grid as a torus.
+ */
+void World::step_bands(const bool toroidal) {
+    const std::size_t width = current_grid.get_width();
+    const std::size_t height = current_grid.get_height();
+    GridMemory::for_each_band(height, width, [&](const std::size_t first, const std::size_t last) {
+        for (std::size_t y = first; y < last; y++){
+            //Rows off a bounded grid are missing, rows off a torus wrap round
+            const Cell *above = nullptr;
+            const Cell *below = nullptr;
+            if (y > 0 || toroidal){
+                above = current_grid.row((y > 0) ? y - 1 : height - 1, Grid::unchecked);
+            }
+            if (y + 1 < height || toroidal){
+                below = current_grid.row((y + 1 < height) ? y + 1 : 0, Grid::unchecked);
+            }
+            Kernel::step_row(above, current_grid.row(y, Grid::unchecked), below, next_grid.row(y, Grid::unchecked),
+                             width, toroidal);
+        }
+    }, threads);
+
+    std::swap(next_grid, current_grid);
+}
+
+/**
+ * World::advance_wavefront(steps, toroidal)
+ *
+ * Private helper that advances several generations at once. With k threads, thread i computes generations
+ * i + 1, i + 1 + k, i + 1 + 2k and so on, each into its own buffer from a ring of k + 1 grids. Instead of waiting
+ * for a whole generation at a barrier, a thread only waits for the three rows of the previous generation the
+ * row it is computing depends on. Each generation publishes how many of its rows are done through an atomic
+ * counter, so generation g + 1 follows a couple of rows behind generation g and k generations are in flight.
+ *      - A buffer is only reused by the thread that wrote the generation reading from it, once it is finished
+ *        with it, so the ring of buffers needs no further synchronisation.
+ *      - On a torus the first row of a generation needs the last row of the one before. Each generation starts
+ *        one row further round than the last so it can still follow its predecessor around the ring.
+ *      - Generations already in flight cannot take edits, and only the last one could be published, so
+ *        World::advance never uses a wavefront while an edit queue or snapshot publisher is connected.
+ *
+ * @param steps
+ *      The number of steps to advance the world forward.
+ *
+ * @param toroidal
+ *      If true then the steps will consider the grid as a torus.
+ */
+void World::advance_wavefront(const std::size_t steps, const bool toroidal) {
+    const std::size_t width = current_grid.get_width();
+    const std::size_t height = current_grid.get_height();
+    const std::size_t threads = std::min<std::size_t>(get_threads(), steps);
+    if (threads <= 1 || width == 0 || height == 0){
+        for (std::size_t i = 0; i < steps; i++){
+            step(toroidal);
+        }
+        return;
+    }
+
+    //Generation n lives in buffers[n % slots], generation 0 being the current state
+    const std::size_t slots = threads + 1;
+    std::vector<Grid> extra;
+    extra.reserve(slots - 2);
+    std::vector<Grid *> buffers = {&current_grid, &next_grid};
+    for (std::size_t i = 2; i < slots; i++){
+        extra.emplace_back(width, height);
+        buffers.push_back(&extra.back());
+    }
+
+    //The counter for generation n holds n * height plus the number of its rows done, so a counter still holding
+    //an older generation reads as no rows done and one already holding a newer generation as every row done
+    const std::uint64_t rows = height;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> progress(new std::atomic<std::uint64_t>[slots]);
+    progress[0].store(rows);
+    for (std::size_t i = 1; i < slots; i++){
+        progress[i].store(i * rows);
+    }
+
+    auto first_row = [&](const std::uint64_t n) -> std::size_t {
+        return toroidal ? static_cast<std::size_t>(n % rows) : 0;
+    };
+    auto row_done = [&](const std::uint64_t n, const std::size_t y) -> bool {
+        const std::uint64_t value = progress[n % slots].load(std::memory_order_acquire);
+        if (value < n * rows){
+            return false;
+        }
+        const std::uint64_t done = value - n * rows;
+        return done >= rows || (y + height - first_row(n)) % height < done;
+    };
+    auto wait_for = [&](const std::uint64_t n, const std::size_t y) {
+        while (!row_done(n, y)){
+            std::this_thread::yield();
+        }
+    };
+
+    auto worker = [&](const std::size_t thread) {
+        for (std::uint64_t n = thread + 1; n <= steps; n += threads){
+            const Grid &in = *buffers[(n - 1) % slots];
+            Grid &out = *buffers[n % slots];
+            progress[n % slots].store(n * rows, std::memory_order_release);
+
+            for (std::size_t i = 0; i < height; i++){
+                const std::size_t y = (first_row(n) + i) % height;
+
+                //Wait for the rows of the previous generation this row depends on
+                const Cell *above = nullptr;
+                const Cell *below = nullptr;
+                if (y > 0 || toroidal){
+                    const std::size_t up = (y > 0) ? y - 1 : height - 1;
+                    wait_for(n - 1, up);
+                    above = in.row(up, Grid::unchecked);
+                }
+                wait_for(n - 1, y);
+                if (y + 1 < height || toroidal){
+                    const std::size_t down = (y + 1 < height) ? y + 1 : 0;
+                    wait_for(n - 1, down);
+                    below = in.row(down, Grid::unchecked);
+                }
+
+                Kernel::step_row(above, in.row(y, Grid::unchecked), below, out.row(y, Grid::unchecked), width, toroidal);
+                progress[n % slots].store(n * rows + i + 1, std::memory_order_release);
+            }
+        }
+    };
+
+    //The calling thread takes the first generation itself
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; i++){
+        workers.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : workers){
+        thread.join();
+    }
+
+    //Bring the last generation round to be the current state, next_grid keeps one of the other buffers
+    if (steps % slots != 0){
+        std::swap(current_grid, *buffers[steps % slots]);
+    }
+    finish_generations(steps);
+}
+
 /**
  * World::step(toroidal)
  *
  * Take one step in Conway's Game of Life.
  *
  * Reads from the current state grid and writes to the next state grid. Then swaps the grids.
+ * If an edit queue is connected, its edits are applied to the current state first.
+ * If a snapshot publisher is connected, the new state is published to it afterwards.
  * Should be implemented by invoking World::count_neighbours(x, y, toroidal).
  * Swapping the grids should be done in O(1) constant time, and should not invoke a copy.
  * Try and boil the logic down to the fewest and most simple conditional statements.
@@ -424,29 +784,46 @@ unsigned int World::get_alive_cells() const {
  *      - Any live cell with more than three live neighbours dies, as if by overpopulation.
  *      - Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
  *
+ * In the Bands step mode, which worlds start in, and the Wavefront mode the step is done by World::step_bands
+ * instead, with the same result. Only StepMode::Serial steps through World::count_neighbours.
+ *
  * @param toroidal
  *      Optional parameter. If true then the step will consider the grid as a torus, where the left edge
  *      wraps to the right edge and the top to the bottom. Defaults to false.
  */
  void World::step(bool toroidal){
+     //Bring in any edits sent since the last generation
+     if (edits != nullptr){
+         edits->apply(current_grid);
+     }
+
+     //The threaded modes have their own row based step
+     if (mode != StepMode::Serial){
+         step_bands(toroidal);
+         finish_generations(1);
+         return;
+     }
+
      //For each cell in the current grid
-     for (unsigned int i = 0; i < current_grid.get_height(); i++){
-         for (unsigned int j = 0; j < current_grid.get_width(); j++){
+     for (std::size_t i = 0; i < current_grid.get_height(); i++){
+         for (std::size_t j = 0; j < current_grid.get_width(); j++){
              //For the current cell, count the number of neighbours it has, whether it is toroidal or not
-             unsigned int neighbours = count_neighbours(j, i, toroidal);
+             std::size_t neighbours = count_neighbours(j, i, toroidal);
              //If statement for the neighbours result
-             if ((neighbours <= 1) || (neighbours > 3)){
-                 //Dead if 0,1 or 3+ alive neighbours
-                 next_grid.set(j, i, Cell::DEAD);
-             } else if ((neighbours == 3) || ((neighbours == 2) && (current_grid.get(j, i) == Cell::ALIVE))){
-                 //Alive if either 3 neighbours alive or if the cell is currently alive and has 3 neighbours
-                 next_grid.set(j, i, Cell::ALIVE);
+             //Every cell of the next grid is written, so it can be reused from step to step without clearing it
+             //j and i come straight from the loop bounds so the unchecked accessors are safe
+             if ((neighbours == 3) || ((neighbours == 2) && (current_grid.get(j, i, Grid::unchecked) == Cell::ALIVE))){
+                 //Alive if either 3 neighbours alive or if the cell is currently alive and has 2 neighbours
+                 next_grid.set(j, i, Cell::ALIVE, Grid::unchecked);
+             } else {
+                 //Dead otherwise, through under or over population
+                 next_grid.set(j, i, Cell::DEAD, Grid::unchecked);
              }
          }
      }
 
      std::swap(next_grid, current_grid);
-     next_grid = Grid(current_grid.get_width(), current_grid.get_height());
+     finish_generations(1);
  }
 
 
@@ -455,6 +832,9 @@ unsigned int World::get_alive_cells() const {
  *
  * Advance multiple steps in the Game of Life.
  * Should be implemented by invoking World::step(toroidal).
+ * In the Wavefront step mode the steps are pipelined across threads by World::advance_wavefront instead, unless
+ * an edit queue or snapshot publisher is connected. Edits have to be applied between every pair of generations
+ * and every generation has to be published, so then the steps are taken one at a time with the row kernel.
  *
  * @param steps
  *      The number of steps to advance the world forward.
@@ -463,9 +843,292 @@ unsigned int World::get_alive_cells() const {
  *      Optional parameter. If true then the step will consider the grid as a torus, where the left edge
  *      wraps to the right edge and the top to the bottom. Defaults to false.
  */
-void World::advance(unsigned int steps, bool toroidal){
+void World::advance(std::size_t steps, bool toroidal){
+    if (mode == StepMode::Wavefront && edits == nullptr && publisher == nullptr){
+        advance_wavefront(steps, toroidal);
+        return;
+    }
+
     //Perform the step method steps number of times
-    for (unsigned int i = 0; i < steps; i++){
+    for (std::size_t i = 0; i < steps; i++){
         this -> step(toroidal);
     }
 }
+
+/**
+ * World::advance_for(budget, max_steps, toroidal = false, cancel = nullptr)
+ *
+ * Advance as many steps as fit in a time budget, up to max_steps, so a front end can hold a frame rate however
+ * big or busy the world is.
+ *
+ * Before each step the time it will take is predicted from a cost model, and the step is only taken if it is
+ * expected to finish within the budget. The model keeps running averages of the time per cell of a step and of
+ * how far steps stray from it, and a step is predicted to take the average plus twice the deviation. It is
+ * updated after every step and kept between calls, so it follows the world as its size and activity change.
+ *      - Until the model has seen a step, one step is taken if there is any budget at all.
+ *      - Another thread can stop the advance early by setting cancel, which is checked between steps.
+ *      - In the Wavefront step mode the steps are taken one at a time with the row kernel, so they can be timed
+ *        and cancelled individually.
+ *
+ * @example
+ *
+ *      // Run the simulation as fast as the display allows, stopping when the window closes
+ *      std::atomic<bool> closing(false);
+ *      while (!closing){
+ *          world.advance_for(std::chrono::milliseconds(14), 1000, true, &closing);
+ *          draw(world.get_state());
+ *      }
+ *
+ * @param budget
+ *      The time the steps may take in total.
+ *
+ * @param max_steps
+ *      The most steps to take, however much budget is left.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the steps will consider the grid as a torus. Defaults to false.
+ *
+ * @param cancel
+ *      Optional parameter. If given, no further steps are taken once it becomes true. Defaults to nullptr.
+ *
+ * @return
+ *      The number of steps taken.
+ */
+std::size_t World::advance_for(const std::chrono::nanoseconds budget, const std::size_t max_steps, const bool toroidal,
+                               const std::atomic<bool> *cancel) {
+    //How quickly the averages follow new timings
+    const double weight = 0.25;
+
+    const auto start = std::chrono::steady_clock::now();
+    const double cells = static_cast<double>(std::max<std::size_t>(current_grid.get_total_cells(), 1));
+    std::size_t steps = 0;
+    while (steps < max_steps){
+        if (cancel != nullptr && cancel->load(std::memory_order_acquire)){
+            break;
+        }
+
+        //Only take the step if it is expected to fit in what is left of the budget
+        const auto before = std::chrono::steady_clock::now();
+        const double remaining = static_cast<double>((budget - (before - start)).count());
+        const double predicted = (step_cost + 2.0 * step_deviation) * cells;
+        if (remaining <= 0.0 || predicted > remaining){
+            break;
+        }
+
+        step(toroidal);
+        steps++;
+
+        //Fold the timing of this step into the model
+        const double taken = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - before).count()) / cells;
+        if (step_cost == 0.0){
+            step_cost = taken;
+        } else {
+            step_deviation += weight * (std::abs(taken - step_cost) - step_deviation);
+            step_cost += weight * (taken - step_cost);
+        }
+    }
+    return steps;
+}
+
+/**
+ * World::get_step_estimate()
+ *
+ * Gets how long the next step is expected to take according to the cost model used by World::advance_for.
+ *
+ * @return
+ *      The average time a step of a world this size has taken, or 0 if no step has been timed yet.
+ */
+std::chrono::nanoseconds World::get_step_estimate() const {
+    return std::chrono::nanoseconds(static_cast<long long>(step_cost * static_cast<double>(current_grid.get_total_cells())));
+}
+
+namespace {
+    //A rectangle of cells at some generation of a light cone, in grid coordinates that may run off the grid
+    struct Cone {
+        long long x0, y0, x1, y1;
+        std::vector<Cell> cells;
+
+        std::size_t width() const {
+            return static_cast<std::size_t>(x1 - x0);
+        }
+
+        Cell* row(const long long y) {
+            return &cells[static_cast<std::size_t>(y - y0) * width()];
+        }
+    };
+
+    //The bounds of the light cone radius cells out from the query, which on a bounded grid never needs to reach
+    //further than the ring of dead cells just outside it
+    Cone cone_bounds(const long long x0, const long long y0, const long long x1, const long long y1,
+                     const long long radius, const long long width, const long long height, const bool toroidal) {
+        Cone cone{x0 - radius, y0 - radius, x1 + radius, y1 + radius, {}};
+        if (!toroidal){
+            cone.x0 = std::max(cone.x0, -1LL);
+            cone.y0 = std::max(cone.y0, -1LL);
+            cone.x1 = std::min(cone.x1, width + 1);
+            cone.y1 = std::min(cone.y1, height + 1);
+        }
+        cone.cells.assign(cone.width() * static_cast<std::size_t>(cone.y1 - cone.y0), Cell::DEAD);
+        return cone;
+    }
+
+    //Wraps a coordinate that may be any distance off the grid back onto it
+    std::size_t wrap(const long long value, const long long size) {
+        return static_cast<std::size_t>(((value % size) + size) % size);
+    }
+}
+
+/**
+ * World::query(x, y, generations, toroidal = false)
+ *
+ * Find the state a single cell will have after a number of generations, without changing the world.
+ * See World::query(x, y, width, height, generations, toroidal) for how.
+ *
+ * @example
+ *
+ *      // Check whether anything reaches a detector site in the next 500 generations
+ *      if (world.query(200, 40, 500) == Cell::ALIVE){
+ *          ...
+ *      }
+ *
+ * @param x
+ *      The x coordinate of the cell.
+ *
+ * @param y
+ *      The y coordinate of the cell.
+ *
+ * @param generations
+ *      How many generations ahead to look.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the generations will consider the grid as a torus. Defaults to false.
+ *
+ * @return
+ *      The state of the cell after that many generations.
+ *
+ * @throws
+ *      std::out_of_range if x, y is not a valid coordinate within the world.
+ */
+Cell World::query(const std::size_t x, const std::size_t y, const std::size_t generations, const bool toroidal) const {
+    return query(x, y, 1, 1, generations, toroidal).get(0, 0, Grid::unchecked);
+}
+
+/**
+ * World::query(x, y, width, height, generations, toroidal = false)
+ *
+ * Find the state a region will have after a number of generations, without changing the world.
+ *
+ * A cell can only be influenced by cells at most one step away per generation, so the state of the region after
+ * n generations depends only on the region grown by n cells on every side. That backward light cone is copied out
+ * of the current state, then stepped with the row kernel while it shrinks by a cell on every side each
+ * generation, until only the region itself is left.
+ *      - A point query costs about (4/3)n^3 cell updates, however large the world is, where World::advance would
+ *        cost n times the area of the world.
+ *      - On a bounded grid the cone is clipped to the grid and the ring of dead cells around it.
+ *      - On a torus the cone wraps round, and if it would be bigger than the world a copy of the whole world is
+ *        advanced instead.
+ *
+ * @example
+ *
+ *      // Read a 16x16 detector window 1000 generations ahead of a huge world
+ *      Grid window = world.query(5000, 5000, 16, 16, 1000, true);
+ *
+ * @param x
+ *      The left coordinate of the region.
+ *
+ * @param y
+ *      The top coordinate of the region.
+ *
+ * @param width
+ *      The width of the region.
+ *
+ * @param height
+ *      The height of the region.
+ *
+ * @param generations
+ *      How many generations ahead to look.
+ *
+ * @param toroidal
+ *      Optional parameter. If true then the generations will consider the grid as a torus. Defaults to false.
+ *
+ * @return
+ *      A new width x height grid holding the region after that many generations.
+ *
+ * @throws
+ *      std::out_of_range if the region does not lie within the world.
+ */
+Grid World::query(const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height,
+                  const std::size_t generations, const bool toroidal) const {
+    const std::size_t grid_width = current_grid.get_width();
+    const std::size_t grid_height = current_grid.get_height();
+    if (x > grid_width || width > grid_width - x || y > grid_height || height > grid_height - y){
+        throw std::out_of_range("Query region is not within the world");
+    }
+    if (width == 0 || height == 0){
+        return Grid(width, height);
+    }
+
+    //Once the cone covers more than the whole torus it is cheaper to step everything
+    const double span = 2.0 * static_cast<double>(generations);
+    if (toroidal && (width + span) * (height + span) >= static_cast<double>(current_grid.get_total_cells())){
+        World copy(current_grid);
+        copy.advance(generations, true);
+        return copy.get_state().crop(x, y, x + width, y + height);
+    }
+
+    const long long gw = static_cast<long long>(grid_width);
+    const long long gh = static_cast<long long>(grid_height);
+    const long long qx0 = static_cast<long long>(x);
+    const long long qy0 = static_cast<long long>(y);
+    const long long qx1 = qx0 + static_cast<long long>(width);
+    const long long qy1 = qy0 + static_cast<long long>(height);
+    auto outside = [&](const long long value, const long long size) { return value < 0 || value >= size; };
+
+    //Copy out the base of the cone, cells off a bounded grid staying dead
+    long long radius = static_cast<long long>(generations);
+    Cone cone = cone_bounds(qx0, qy0, qx1, qy1, radius, gw, gh, toroidal);
+    for (long long cy = cone.y0; cy < cone.y1; cy++){
+        if (!toroidal && outside(cy, gh)){
+            continue;
+        }
+        const Cell *src = current_grid.row(wrap(cy, gh), Grid::unchecked);
+        Cell *dst = cone.row(cy);
+        for (long long cx = cone.x0; cx < cone.x1; cx++){
+            if (toroidal || !outside(cx, gw)){
+                dst[cx - cone.x0] = src[wrap(cx, gw)];
+            }
+        }
+    }
+
+    //Step the cone up a generation at a time, each one a cell smaller on every side that is not clipped
+    std::vector<Cell> out;
+    while (radius > 0){
+        radius--;
+        Cone next = cone_bounds(qx0, qy0, qx1, qy1, radius, gw, gh, toroidal);
+
+        //Only cells on the grid are computed, the ring outside a bounded grid stays dead
+        const long long cx0 = toroidal ? next.x0 : std::max(next.x0, 0LL);
+        const long long cx1 = toroidal ? next.x1 : std::min(next.x1, gw);
+        const std::size_t span_width = static_cast<std::size_t>(cx1 - cx0) + 2;
+        out.resize(span_width);
+        for (long long cy = next.y0; cy < next.y1; cy++){
+            if (!toroidal && outside(cy, gh)){
+                continue;
+            }
+            //The previous cone always holds the column either side of the span and the row either side of cy
+            const std::size_t offset = static_cast<std::size_t>(cx0 - 1 - cone.x0);
+            Kernel::step_row(cone.row(cy - 1) + offset, cone.row(cy) + offset, cone.row(cy + 1) + offset,
+                             out.data(), span_width, false);
+            std::memcpy(next.row(cy) + (cx0 - next.x0), out.data() + 1, (span_width - 2) * sizeof(Cell));
+        }
+        cone = std::move(next);
+    }
+
+    //All that is left of the cone is the region itself
+    Grid result(width, height);
+    for (std::size_t i = 0; i < height; i++){
+        std::memcpy(result.row(i, Grid::unchecked), cone.row(qy0 + static_cast<long long>(i)), width * sizeof(Cell));
+    }
+    return result;
+}
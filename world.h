@@ -11,9 +11,29 @@
 #pragma once
 
 // Add the minimal number of includes you need in order to declare the class.
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <vector>
 #include "grid.h"
 
+class EditQueue;
+class SnapshotPublisher;
+
+/**
+ * The ways a World can be stepped.
+ *      - Serial: one cell at a time on the calling thread, through World::count_neighbours.
+ *      - Bands: a row at a time with the row kernel, the rows split into one band per thread each generation.
+ *        The default, grids too small to be worth splitting are stepped on the calling thread.
+ *      - Wavefront: several generations at once, each thread one generation behind the next, for grids too
+ *        small for bands to be worthwhile.
+ */
+enum class StepMode : unsigned char {
+    Serial,
+    Bands,
+    Wavefront
+};
+
 /**
  * Declare the structure of the World class for representing a 2d grid world.
  *
@@ -27,33 +47,94 @@ private:
     Grid current_grid;
     Grid next_grid;
 
+    //How step and advance do their work, and how many threads the threaded modes use, 0 meaning the
+    //GridMemory thread count
+    StepMode mode;
+    unsigned int threads;
+
+    //Running averages of the time a step takes per cell and how far steps stray from it, in nanoseconds
+    //They are 0 until the first step has been timed
+    double step_cost;
+    double step_deviation;
+
+    //Edits sent in by other threads, applied between generations, not owned by the world
+    EditQueue *edits;
+
+    //Where completed generations are published for other threads to read, not owned by the world
+    SnapshotPublisher *publisher;
+
+    //How many generations the world has been stepped since it was made
+    std::uint64_t generation;
+
     //Private function used to count for each item in a grid the number of alive neighbours it has
-    unsigned int count_neighbours(unsigned int x, unsigned int y, bool toroidal);
+    std::size_t count_neighbours(std::size_t x, std::size_t y, bool toroidal);
+
+    //Private functions used to step with the row kernel across threads
+    void step_bands(bool toroidal);
+    void advance_wavefront(std::size_t steps, bool toroidal);
+
+    //Private function used to count the generations just completed and publish the latest
+    void finish_generations(std::size_t steps);
 public:
     //Four constructors for the world class (four?? four constructors Joss? That's insane)
     //One for an empty world, one for a square world, one with a given width and height and one with a pre-made grid
     World();
-    explicit World(unsigned int size);
-    World(unsigned int width, unsigned int height);
+    explicit World(std::size_t size);
+    World(std::size_t width, std::size_t height);
     explicit World(const Grid& initial_state);
 
     //Getters and setters that mirror that of the grid class but it returns the information relating to the current grid
-    unsigned int get_width() const;
-    unsigned int get_height() const;
-    unsigned int get_total_cells() const;
-    unsigned int get_alive_cells() const;
-    unsigned int get_dead_cells() const;
+    std::size_t get_width() const;
+    std::size_t get_height() const;
+    std::size_t get_total_cells() const;
+    std::size_t get_alive_cells() const;
+    std::size_t get_dead_cells() const;
 
     //Returns the current grid member
     const Grid& get_state() const;
 
     //Resizing of the current grid using a square size of width and height
-    void resize(unsigned int new_square_size);
-    void resize(unsigned int new_width, unsigned int new_height);
+    void resize(std::size_t new_square_size);
+    void resize(std::size_t new_width, std::size_t new_height);
+
+    //Expands the world by a margin of dead cells on each side, keeping the current state in place
+    void grow(std::size_t left, std::size_t top, std::size_t right, std::size_t bottom);
+
+    //Connects a queue of edits that is drained before every generation, or disconnects it with nullptr
+    void set_edit_queue(EditQueue *queue);
+
+    //Connects a publisher that every completed generation is copied to, or disconnects it with nullptr
+    void set_snapshot_publisher(SnapshotPublisher *publisher);
+
+    //The number of generations stepped since the world was made
+    std::uint64_t get_generation() const;
+
+    //Chooses how the world is stepped, the results are the same whichever is used
+    //While an edit queue or snapshot publisher is connected Wavefront steps a generation at a time, so edits
+    //still go in between generations and every generation is published
+    void set_step_mode(StepMode mode);
+    StepMode get_step_mode() const;
+
+    //Sets how many threads this world is stepped with in the threaded modes, 0 for GridMemory::get_threads()
+    void set_threads(unsigned int threads);
+    unsigned int get_threads() const;
 
     //Used to perform a single step in the grid, updating the current grid to the next state
     void step(bool toroidal = false);
 
     //Used to perform multiple steps in the grid, updating the current grid to the result of n steps
-    void advance(unsigned int steps, bool toroidal = false);
+    void advance(std::size_t steps, bool toroidal = false);
+
+    //Used to step for as long as a time budget allows, returning the number of steps taken
+    std::size_t advance_for(std::chrono::nanoseconds budget, std::size_t max_steps, bool toroidal = false,
+                            const std::atomic<bool> *cancel = nullptr);
+
+    //How long the next step is expected to take, 0 until a step has been timed by advance_for
+    std::chrono::nanoseconds get_step_estimate() const;
+
+    //Used to find the state of a single cell or a region some generations ahead, without changing the world
+    //Only the backward light cone of the query is computed rather than the whole grid
+    Cell query(std::size_t x, std::size_t y, std::size_t generations, bool toroidal = false) const;
+    Grid query(std::size_t x, std::size_t y, std::size_t width, std::size_t height, std::size_t generations,
+               bool toroidal = false) const;
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
  * Implements a Zoo namespace with methods for constructing Grid objects containing various creatures in the Game of Life.
  *      - Creatures like gliders, light weight spaceships, and r-pentominos can be spawned.
  *          - These creatures are drawn on a Grid the size of their bounding box.
+ *          - Every phase and rotation of each creature is also available as a compile time constant in the
+ *            catalogue declared in zoo.h, which can be stamped into a grid without allocating anything.
  *
  *      - Grids can be loaded from and saved to an ascii file format.
  *          - Ascii files are composed of:
@@ -21,6 +23,7 @@
  * @author 953238
  * @date March, 2020
  */
+#include <cstdint>
 #include <fstream>
 #include "zoo.h"
 
@@ -28,7 +31,7 @@
 // #include ...
 
 /**
- * Zoo::glider()
+ * Zoo::glider(resource = nullptr)
  *
  * Construct a 3x3 grid containing a glider.
  * https://www.conwaylife.com/wiki/Glider
@@ -44,22 +47,20 @@
  *      |###|
  *      +---+
  *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate the grid from, defaults to the default resource.
+ *
  * @return
  *      Returns a Grid containing a glider.
  */
- Grid Zoo::glider() {
-     Grid g(3,3);
-     g.set(0, 2, Cell::ALIVE);
-     g.set(1, 2, Cell::ALIVE);
-     g.set(2, 2, Cell::ALIVE);
-     g.set(2, 1, Cell::ALIVE);
-     g.set(1, 0, Cell::ALIVE);
-     return g;
+ Grid Zoo::glider(std::pmr::memory_resource *resource) {
+     //Copied out of the catalogue, which was built at compile time
+     return glider_pattern.get<0>().to_grid(resource);
  }
 
 
 /**
- * Zoo::r_pentomino()
+ * Zoo::r_pentomino(resource = nullptr)
  *
  * Construct a 3x3 grid containing an r-pentomino.
  * https://www.conwaylife.com/wiki/R-pentomino
@@ -75,21 +76,18 @@
  *      | # |
  *      +---+
  *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate the grid from, defaults to the default resource.
+ *
  * @return
  *      Returns a Grid containing a r-pentomino.
  */
-Grid Zoo::r_pentomino() {
-    Grid r_p(3,3);
-    r_p.set(1, 0, Cell::ALIVE);
-    r_p.set(2, 0, Cell::ALIVE);
-    r_p.set(0, 1, Cell::ALIVE);
-    r_p.set(1, 1, Cell::ALIVE);
-    r_p.set(1, 2, Cell::ALIVE);
-    return r_p;
+Grid Zoo::r_pentomino(std::pmr::memory_resource *resource) {
+    return r_pentomino_pattern.get<0>().to_grid(resource);
 }
 
 /**
- * Zoo::light_weight_spaceship()
+ * Zoo::light_weight_spaceship(resource = nullptr)
  *
  * Construct a 5x4 grid containing a light weight spaceship.
  * https://www.conwaylife.com/wiki/Lightweight_spaceship
@@ -106,25 +104,18 @@ Grid Zoo::r_pentomino() {
  *      |#### |
  *      +-----+
  *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate the grid from, defaults to the default resource.
+ *
  * @return
  *      Returns a grid containing a light weight spaceship.
  */
-Grid Zoo::light_weight_spaceship() {
-    Grid l_w_p(5,4);
-    l_w_p.set(1, 0, Cell::ALIVE);
-    l_w_p.set(4, 0, Cell::ALIVE);
-    l_w_p.set(0, 1, Cell::ALIVE);
-    l_w_p.set(0, 2, Cell::ALIVE);
-    l_w_p.set(4, 2, Cell::ALIVE);
-    l_w_p.set(0, 3, Cell::ALIVE);
-    l_w_p.set(1, 3, Cell::ALIVE);
-    l_w_p.set(2, 3, Cell::ALIVE);
-    l_w_p.set(3, 3, Cell::ALIVE);
-    return l_w_p;
+Grid Zoo::light_weight_spaceship(std::pmr::memory_resource *resource) {
+    return light_weight_spaceship_pattern.get<0>().to_grid(resource);
 }
 
 /**
- * Zoo::load_ascii(path)
+ * Zoo::load_ascii(path, resource = nullptr)
  *
  * Load an ascii file and parse it as a grid of cells.
  * Should be implemented using std::ifstream.
@@ -137,6 +128,9 @@ Grid Zoo::light_weight_spaceship() {
  * @param path
  *      The std::string path to the file to read in.
  *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate the grid from, defaults to the default resource.
+ *
  * @return
  *      Returns the parsed grid.
  *
@@ -147,7 +141,7 @@ Grid Zoo::light_weight_spaceship() {
  *          - Newline characters are not found when expected during parsing.
  *          - The character for a cell is not the ALIVE or DEAD character.
  */
-Grid Zoo::load_ascii(const std::string& path) {
+Grid Zoo::load_ascii(const std::string& path, std::pmr::memory_resource *resource) {
     try {
         //Open file into ifstream
         std::ifstream inFile(path);
@@ -155,20 +149,22 @@ Grid Zoo::load_ascii(const std::string& path) {
         //If the file could be opened for reading...
         if (inFile.is_open()) {
             //Only initialising to shut up clang tidy
-            int width = 0;
-            int height = 0;
+            long long read_width = 0;
+            long long read_height = 0;
 
             //Read in width and height, >> skips over whitespace
-            inFile >> width >> height;
-            if (width < 0 || height < 0){
+            inFile >> read_width >> read_height;
+            if (read_width < 0 || read_height < 0){
                 //Check that both the width and height are positive
                 throw std::runtime_error("The width, height or both are negative which is invalid");
             }
+            const auto width = static_cast<std::size_t>(read_width);
+            const auto height = static_cast<std::size_t>(read_height);
 
             //Create a new empty using the width and height
-            Grid out_grid(width, height);
-            for (int i = 0; i < height; i++){
-                for (int j = 0; j < width; j++){
+            Grid out_grid(width, height, resource);
+            for (std::size_t i = 0; i < height; i++){
+                for (std::size_t j = 0; j < width; j++){
                     //Read in value for each item in grid, using .get as it doesn't skip whitespace
                     //Set cell value as either alive or dead
                     char val = inFile.get();
@@ -195,7 +191,7 @@ Grid Zoo::load_ascii(const std::string& path) {
             //WHen reading in the glider, the glider was one column over than it was supposed to be
             //By cropping it fixes the problem somehow and passes the tests, though this may cause an issue in special
             //cases however I have not tested this further.
-            out_grid = out_grid.crop(1, 0, width, height);
+            out_grid = out_grid.crop(1, 0, width, height, resource);
             inFile.close();
             return out_grid;
         } else {
@@ -226,31 +222,34 @@ Grid Zoo::load_ascii(const std::string& path) {
  *          std::cerr << ex.what() << std::endl;
  *      }
  *
+ *      // Save just the top left 4x4 of the grid without cropping it first
+ *      Zoo::save_ascii("path/to/corner.gol", grid.view(0, 0, 4, 4));
+ *
  * @param path
  *      The std::string path to the file to write to.
  *
  * @param grid
- *      The grid to be written out to file.
+ *      The grid, or view of a grid, to be written out to file.
  *
  * @throws
  *      Throws std::runtime_error or sub-class if the file cannot be opened.
  */
- void Zoo::save_ascii(const std::string& path, const Grid &grid) {
+ void Zoo::save_ascii(const std::string& path, const GridView &grid) {
      try {
          //Open file into output stream
          std::ofstream outFile(path);
 
          //If file could be opened...
          if (outFile.is_open()) {
-             unsigned int width = grid.get_width();
-             unsigned int height = grid.get_height();
+             std::size_t width = grid.get_width();
+             std::size_t height = grid.get_height();
 
              //Feed the width and height into the file with a new line added
              outFile << width << ' ' << height << '\n';
 
              //For each cell in the grid...
-             for (unsigned int i = 0; i < height; i++){
-                 for (unsigned int j = 0; j < width; j++){
+             for (std::size_t i = 0; i < height; i++){
+                 for (std::size_t j = 0; j < width; j++){
                      Cell val = grid.get(j,i);
 
                      //Depending on value, write a ' ' or a '#'
@@ -274,7 +273,7 @@ Grid Zoo::load_ascii(const std::string& path) {
  }
 
 /**
- * Zoo::load_binary(path)
+ * Zoo::load_binary(path, resource = nullptr)
  *
  * Load a binary file and parse it as a grid of cells.
  * Should be implemented using std::ifstream.
@@ -287,6 +286,9 @@ Grid Zoo::load_ascii(const std::string& path) {
  * @param path
  *      The std::string path to the file to read in.
  *
+ * @param resource
+ *      Optional parameter. The memory resource to allocate the grid from, defaults to the default resource.
+ *
  * @return
  *      Returns the parsed grid.
  *
@@ -297,19 +299,20 @@ Grid Zoo::load_ascii(const std::string& path) {
  */
 
 //See README for implementation explanation
-Grid Zoo::load_binary(const std::string &path) {
+Grid Zoo::load_binary(const std::string &path, std::pmr::memory_resource *resource) {
     try {
         std::ifstream inFile(path, std::ios::in | std::ios::binary);
         if (inFile.is_open()) {
-            unsigned int width;
-            unsigned int height;
-            inFile.read(reinterpret_cast<char *>(&width), sizeof(int));
-            inFile.read(reinterpret_cast<char *>(&height), sizeof(int));
+            //The file format stores 4 byte dimensions regardless of how large a grid can be in memory
+            std::uint32_t width;
+            std::uint32_t height;
+            inFile.read(reinterpret_cast<char *>(&width), sizeof(width));
+            inFile.read(reinterpret_cast<char *>(&height), sizeof(height));
 
             std::vector<char> buffer(std::istreambuf_iterator<char>(inFile), {});
             std::vector<Cell> cells;
 
-            Grid out_grid(width, height);
+            Grid out_grid(width, height, resource);
 
             for (auto const& value: buffer){
                 for (unsigned int i = 0; i < 8; i++){
@@ -321,12 +324,12 @@ Grid Zoo::load_binary(const std::string &path) {
                 }
             }
 
-            if (cells.size() < (width * height)){
+            if (cells.size() < (static_cast<std::size_t>(width) * height)){
                 throw std::runtime_error("Unexpected end to binary file, please check input");
             }
 
-            for (unsigned int i = 0; i < height; i++){
-                for (unsigned int j = 0; j < width; j++){
+            for (std::size_t i = 0; i < height; i++){
+                for (std::size_t j = 0; j < width; j++){
                     out_grid.set(j, i, cells.at(i*width + j));
                 }
             }
@@ -365,18 +368,22 @@ Grid Zoo::load_binary(const std::string &path) {
  *      The std::string path to the file to write to.
  *
  * @param grid
- *      The grid to be written out to file.
+ *      The grid, or view of a grid, to be written out to file.
  *
  * @throws
- *      Throws std::runtime_error or sub-class if the file cannot be opened.
+ *      Throws std::runtime_error or sub-class if the file cannot be opened, or if the grid is wider or taller
+ *      than the 4 byte dimensions of the file format can hold.
  */
 //See README for implementation description
-void Zoo::save_binary(const std::string& path, const Grid &grid) {
+void Zoo::save_binary(const std::string& path, const GridView &grid) {
     try {
         std::ofstream outFile(path, std::ios::out | std::ios::binary);
         if (outFile.is_open()) {
-            unsigned int width = grid.get_width();
-            unsigned int height = grid.get_height();
+            if (grid.get_width() > UINT32_MAX || grid.get_height() > UINT32_MAX){
+                throw std::runtime_error("Grid is too large for the binary file format");
+            }
+            std::uint32_t width = grid.get_width();
+            std::uint32_t height = grid.get_height();
 
             outFile.write( reinterpret_cast<const char *>(&width), sizeof(width));
             outFile.write( reinterpret_cast<const char *>(&height), sizeof(height));
@@ -384,8 +391,8 @@ void Zoo::save_binary(const std::string& path, const Grid &grid) {
             int current_bit = 0;
             unsigned char bit_buffer = 0;
 
-            for (unsigned int i = 0; i < height; i++){
-                for (unsigned int j = 0; j < width; j++){
+            for (std::size_t i = 0; i < height; i++){
+                for (std::size_t j = 0; j < width; j++){
                     if (grid.get(j, i) == Cell::ALIVE){
                         bit_buffer |= (1<<current_bit);
                     } else {
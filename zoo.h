@@ -17,17 +17,34 @@
  * Declare the interface of the Zoo namespace for constructing lifeforms and saving and loading them from file.
  */
 #include "grid.h"
+#include "grid_view.h"
+#include "static_grid.h"
 
 namespace Zoo {
+    //The catalogue of lifeforms, every phase and rotation of each worked out by the compiler
+    //Stamping one of these into a grid allocates nothing and does no stepping or rotating at run time
+    inline constexpr Lifeform<3, 3, 4> glider_pattern{StaticGrid<3, 3>(" # "
+                                                                       "  #"
+                                                                       "###")};
+    inline constexpr Lifeform<3, 3, 1> r_pentomino_pattern{StaticGrid<3, 3>(" ##"
+                                                                            "## "
+                                                                            " # ")};
+    inline constexpr Lifeform<5, 4, 4> light_weight_spaceship_pattern{StaticGrid<5, 4>(" #  #"
+                                                                                       "#    "
+                                                                                       "#   #"
+                                                                                       "#### ")};
+
     //These methods create grids within their respective life forms in them
-    Grid glider();
-    Grid r_pentomino();
-    Grid light_weight_spaceship();
+    //Every grid made by the Zoo can be allocated from a given memory resource, such as a GridArena's
+    Grid glider(std::pmr::memory_resource *resource = nullptr);
+    Grid r_pentomino(std::pmr::memory_resource *resource = nullptr);
+    Grid light_weight_spaceship(std::pmr::memory_resource *resource = nullptr);
 
     //These methods are responsible for loading and writing to and from files whilst also handling exceptions
-    Grid load_ascii(const std::string& path);
-    void save_ascii(const std::string& path, const Grid &grid);
-    Grid load_binary(const std::string& path);
-    void save_binary(const std::string& path, const Grid &grid);
+    //Saving takes a view so a window or rotation of a grid can be written out without copying it first
+    Grid load_ascii(const std::string& path, std::pmr::memory_resource *resource = nullptr);
+    void save_ascii(const std::string& path, const GridView &grid);
+    Grid load_binary(const std::string& path, std::pmr::memory_resource *resource = nullptr);
+    void save_binary(const std::string& path, const GridView &grid);
 
 };
\ No newline at end of file